@@ -94,6 +94,8 @@ class LibConan(ConanFile):
         libDir = '%s' % self.settings.build_type
         self.cpp_info.libdirs = [libDir]
         self.cpp_info.libs = tools.collect_libs(self, libDir)
+        if self.settings.os == "Linux":
+            self.cpp_info.libs.append("pthread")
 
 # ----------------------------------------------------------------------------------#
 # //////////////////////////////////////////////////////////////////////////////////#
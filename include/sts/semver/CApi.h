@@ -0,0 +1,193 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+/*
+ * C API for using the library from other languages (Python ctypes/cffi, Go cgo etc.).
+ * The functions work with arrays so a caller crosses the language boundary once per batch.
+ * The header can be used from C and C++, the functions never throw exceptions.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Export.h"
+
+/*! \details Version of the C API, the structures and the functions are only extended when it is changed. */
+#define STS_SEMVER_C_API_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Parsed version.
+ * \details The pre-release and the build point into the source string, they aren't null-terminated.
+ *          So the source must be alive while the version is used.
+ */
+typedef struct sts_semver_version {
+    const char * pre_release;
+    const char * build;
+    uint32_t major;
+    uint32_t minor;
+    uint32_t patch;
+    uint32_t pre_release_length;
+    uint32_t build_length;
+    /*! \details 1 - the version is valid, 0 - the string isn't a valid version, all the other fields are 0. */
+    uint32_t valid;
+} sts_semver_version;
+
+/*!
+ * \details Parsed version range, see sts::semver::Range.
+ */
+typedef struct sts_semver_range sts_semver_range;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \return STS_SEMVER_C_API_VERSION which the library is built with.
+ */
+SemVerExp uint32_t sts_semver_api_version(void);
+
+/*!
+ * \details Parses the strings.
+ * \param [in] strings array of the strings.
+ * \param [in] lengths array of the string lengths, if it is NULL the strings must be null-terminated.
+ * \param [in] count number of the strings.
+ * \param [out] out_versions array of count versions.
+ * \return Number of the valid versions.
+ */
+SemVerExp size_t sts_semver_parse_n(const char * const * strings, const size_t * lengths, size_t count,
+                                    sts_semver_version * out_versions);
+
+/*!
+ * \details Parses the whitespace-separated versions from one buffer, e.g. a file content.
+ *          Each token gets an output version, invalid tokens give invalid versions.
+ * \param [in] data
+ * \param [in] size size of the data in bytes.
+ * \param [out] out_versions array of the capacity versions, may be NULL if the capacity is 0.
+ * \param [in] capacity
+ * \return Number of the tokens, if it is greater than the capacity only the first capacity tokens are parsed.
+ */
+SemVerExp size_t sts_semver_parse_buffer(const char * data, size_t size,
+                                         sts_semver_version * out_versions, size_t capacity);
+
+/*!
+ * \details Compares the versions by the semver precedence, the build is ignored.
+ *          An invalid version is lower than any valid one.
+ * \return -1 if left < right, 0 if left == right, 1 if left > right.
+ */
+SemVerExp int sts_semver_compare(const sts_semver_version * left, const sts_semver_version * right);
+
+/*!
+ * \details Compares the versions pairwise, see sts_semver_compare.
+ * \param [in] left array of count versions.
+ * \param [in] right array of count versions.
+ * \param [in] count
+ * \param [out] out_results array of count results.
+ */
+SemVerExp void sts_semver_compare_n(const sts_semver_version * left, const sts_semver_version * right, size_t count,
+                                    int8_t * out_results);
+
+/*!
+ * \details Sorts the versions in ascending order of the precedence, see sts_semver_compare.
+ *          The sort is stable.
+ * \param [in, out] versions
+ * \param [in] count
+ */
+SemVerExp void sts_semver_sort(sts_semver_version * versions, size_t count);
+
+/*!
+ * \details Calculates the positions which sort the versions without moving them,
+ *          it is useful if the caller has other data attached to the versions. The sort is stable.
+ * \param [in] versions
+ * \param [in] count
+ * \param [out] out_indices array of count positions, out_indices[0] is the position of the lowest version.
+ */
+SemVerExp void sts_semver_sort_indices(const sts_semver_version * versions, size_t count, size_t * out_indices);
+
+/*!
+ * \details Formats the versions into one buffer separated by the separator.
+ * \param [in] versions
+ * \param [in] count
+ * \param [in] with_pre_release 0 - the pre-releases aren't written.
+ * \param [in] with_build 0 - the builds aren't written.
+ * \param [in] separator character between the versions, e.g. '\n'. Invalid versions give empty strings.
+ * \param [out] out_buffer may be NULL if the capacity is 0.
+ * \param [in] capacity size of the buffer in bytes.
+ * \return Size of the result in bytes including the terminating null.
+ *         If it is greater than the capacity nothing is written, the caller can allocate the buffer and call again.
+ */
+SemVerExp size_t sts_semver_format_n(const sts_semver_version * versions, size_t count,
+                                     int with_pre_release, int with_build, char separator,
+                                     char * out_buffer, size_t capacity);
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Parses the range.
+ * \param [in] range
+ * \param [in] length length of the range string, it doesn't need to be null-terminated.
+ * \return The range which must be freed with sts_semver_range_free or NULL if the range isn't valid.
+ */
+SemVerExp sts_semver_range * sts_semver_range_parse(const char * range, size_t length);
+
+/*!
+ * \param [in] range may be NULL.
+ */
+SemVerExp void sts_semver_range_free(sts_semver_range * range);
+
+/*!
+ * \details Checks which versions satisfy the range. Invalid versions never satisfy it.
+ * \param [in] range may be NULL e.g. the result of sts_semver_range_parse for an invalid range,
+ *                   then no version satisfies it.
+ * \param [in] versions
+ * \param [in] count
+ * \param [out] out_mask array of (count + 7) / 8 bytes,
+ *                       bit (i % 8) of byte (i / 8) is set if versions[i] satisfies the range.
+ * \return Number of the versions which satisfy the range.
+ */
+SemVerExp size_t sts_semver_range_match_n(const sts_semver_range * range, const sts_semver_version * versions,
+                                          size_t count, uint8_t * out_mask);
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,229 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "SemVersion.h"
+
+namespace sts {
+namespace semver {
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    /*!
+     * \details Immutable compact set of versions for big in-memory catalogs.
+     * \details The versions are sorted by \link SemVersion::comparePrecedence \endlink
+     *          (versions with equal precedence are ordered by the build value)
+     *          and split into blocks. The first version of each block is stored as is,
+     *          the others are stored as varint deltas from the previous one.
+     *          Pre-release and build values are stored once in the shared dictionaries,
+     *          the versions have only the indices.
+     * \details Search works with the block headers first so only one block is decoded.
+     *          Typical memory usage is 4-6 bytes per version against
+     *          sizeof(SemVersion) (80 bytes with libstdc++) plus tag allocations for std::vector<SemVersion>.
+     */
+    class CompactVersionSet {
+
+        // Sort key of a version, tags are the dictionary indices.
+        struct Key {
+            std::uint32_t mMajor = 0;
+            std::uint32_t mMinor = 0;
+            std::uint32_t mPatch = 0;
+            // 0 - no pre-release, otherwise index + 1.
+            std::uint32_t mPreRelease = 0;
+            // 0 - no build, otherwise index + 1.
+            std::uint32_t mBuild = 0;
+        };
+
+        struct Block {
+            Key mFirst;
+            // Offset of the second version in the data.
+            std::size_t mOffset;
+        };
+
+    public:
+
+        /*!
+         * \details Forward iterator, it decodes versions one by one.
+         */
+        class Iterator {
+        public:
+
+            typedef std::forward_iterator_tag iterator_category;
+            typedef SemVersion value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const SemVersion * pointer;
+            typedef const SemVersion & reference;
+
+            Iterator() = default;
+
+            reference operator*() const {
+                return mVersion;
+            }
+
+            pointer operator->() const {
+                return &mVersion;
+            }
+
+            SemVerExp Iterator & operator++();
+
+            Iterator operator++(int) {
+                Iterator res(*this);
+                ++(*this);
+                return res;
+            }
+
+            bool operator==(const Iterator & other) const {
+                return mIndex == other.mIndex;
+            }
+
+            bool operator!=(const Iterator & other) const {
+                return mIndex != other.mIndex;
+            }
+
+            /*!
+             * \return Position of the version in the set.
+             */
+            std::size_t index() const {
+                return mIndex;
+            }
+
+        private:
+
+            friend class CompactVersionSet;
+
+            void materialize();
+
+            const CompactVersionSet * mSet = nullptr;
+            std::size_t mIndex = 0;
+            const std::uint8_t * mData = nullptr;
+            Key mKey;
+            SemVersion mVersion;
+
+        };
+
+        //---------------------------------------------------------------
+        // @{
+
+        CompactVersionSet() = default;
+
+        /*!
+         * \param [in] versions any order, duplicates are removed.
+         * \param [in] blockSize number of the versions in one block,
+         *                       bigger blocks give better compression but slower search.
+         */
+        SemVerExp explicit CompactVersionSet(const std::vector<SemVersion> & versions, std::size_t blockSize = 64);
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        std::size_t size() const {
+            return mSize;
+        }
+
+        bool empty() const {
+            return mSize == 0;
+        }
+
+        SemVerExp Iterator begin() const;
+
+        Iterator end() const {
+            Iterator res;
+            res.mSet = this;
+            res.mIndex = mSize;
+            return res;
+        }
+
+        /*!
+         * \param [in] index must be less than size.
+         * \return Iterator to the version at the position.
+         */
+        SemVerExp Iterator at(std::size_t index) const;
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \details Checks whether the set has the version, all the parts including build are compared.
+         * \param [in] version
+         */
+        SemVerExp bool contains(const SemVersion & version) const;
+
+        /*!
+         * \param [in] version
+         * \return Iterator to the first version which has precedence not lower than the given one
+         *         or end if there isn't such version.
+         */
+        SemVerExp Iterator lowerBound(const SemVersion & version) const;
+
+        /*!
+         * \return Number of bytes which the set uses including the dictionaries.
+         */
+        SemVerExp std::size_t memoryUsage() const;
+
+        // @}
+        //---------------------------------------------------------------
+
+    private:
+
+        // Range of the dictionary indices (+ 1) which have the same precedence as a pre-release.
+        struct PreReleaseRange {
+            std::uint32_t mBegin;
+            std::uint32_t mEnd;
+        };
+
+        static int compareKeys(const Key & left, const Key & right);
+        static int comparePrecedence(const Key & key, const SemVersion & version, const PreReleaseRange & preRelease);
+        PreReleaseRange preReleaseRange(const std::string & preRelease) const;
+        static const std::uint8_t * decode(const std::uint8_t * data, Key & inOutKey);
+        static void encode(const Key & previous, const Key & key, std::vector<std::uint8_t> & outData);
+
+        std::vector<Block> mBlocks;
+        std::vector<std::uint8_t> mData;
+        std::vector<std::string> mPreReleases;
+        std::vector<std::string> mBuilds;
+        std::size_t mBlockSize = 64;
+        std::size_t mSize = 0;
+
+    };
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+}
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SemVersion.h"
+
+namespace sts {
+namespace semver {
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    /*!
+     * \details Secondary index of versions by their pre-release identifiers.
+     * \details The pre-releases are split by dots into identifiers, e.g. "beta.2" gives "beta" at position 0
+     *          and "2" at position 1. The identifiers are kept in a sorted dictionary, each identifier
+     *          has a posting list of the versions (and the positions) which contain it,
+     *          so a query reads only the postings of the matched identifiers instead of all the versions.
+     *          A prefix query matches a continuous part of the dictionary.
+     * \details The versions are identified by their positions in the index (insertion order).
+     *          The builds aren't indexed.
+     * \code
+     *     // all 1.x versions on the beta channel
+     *     PreReleaseIndex::Query query;
+     *     query.mIdentifier = "beta";
+     *     query.mMajor.mMin = query.mMajor.mMax = 1;
+     *     const auto ids = index.find(query);
+     * \endcode
+     */
+    class PreReleaseIndex {
+    public:
+
+        /*!
+         * \details Inclusive numeric range.
+         */
+        struct Bounds {
+            std::uint32_t mMin = 0;
+            std::uint32_t mMax = UINT32_MAX;
+
+            bool contains(const std::uint32_t value) const {
+                return mMin <= value && value <= mMax;
+            }
+        };
+
+        struct Query {
+            /*! \details Identifier or its prefix, an empty prefix matches all the identifiers. */
+            std::string mIdentifier;
+            /*! \details True - mIdentifier is a prefix, false - the identifier must match exactly. */
+            bool mPrefix = false;
+            /*! \details Position of the identifier in the pre-release, 0 is the channel e.g. "rc" in "rc.1". */
+            std::size_t mPosition = 0;
+            /*! \details Filters of the version numbers. */
+            Bounds mMajor;
+            Bounds mMinor;
+            Bounds mPatch;
+        };
+
+        //---------------------------------------------------------------
+        // @{
+
+        PreReleaseIndex() = default;
+
+        /*!
+         * \details Bulk construction, it is faster than inserting the versions one by one.
+         * \param [in] versions they get the positions in the same order.
+         */
+        SemVerExp explicit PreReleaseIndex(const std::vector<SemVersion> & versions);
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \details Adds the version to the index.
+         * \param [in] version
+         * \return Position of the version in the index.
+         */
+        SemVerExp std::size_t insert(const SemVersion & version);
+
+        std::size_t size() const {
+            return mVersions.size();
+        }
+
+        bool empty() const {
+            return mVersions.empty();
+        }
+
+        /*!
+         * \param [in] id position of the version, must be less than size.
+         */
+        const SemVersion & version(const std::size_t id) const {
+            return mVersions[id];
+        }
+
+        /*!
+         * \return Number of the unique identifiers in the dictionary.
+         */
+        std::size_t identifierCount() const {
+            return mDictionary.size();
+        }
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \param [in] query
+         * \return Ascending positions of the matching versions.
+         */
+        SemVerExp std::vector<std::size_t> find(const Query & query) const;
+
+        /*!
+         * \details Finds the version with the highest precedence for each major.minor line,
+         *          e.g. the latest "rc" of each minor line.
+         * \param [in] query
+         * \return Positions of the found versions ordered by major and minor.
+         */
+        SemVerExp std::vector<std::size_t> latestPerMinor(const Query & query) const;
+
+        // @}
+        //---------------------------------------------------------------
+
+    private:
+
+        struct Posting {
+            std::uint32_t mVersion;
+            std::uint32_t mPosition;
+        };
+
+        struct Entry {
+            std::string mIdentifier;
+            // Ordered by the version.
+            std::vector<Posting> mPostings;
+        };
+
+        std::vector<SemVersion> mVersions;
+        // Ordered by the identifier bytes.
+        std::vector<Entry> mDictionary;
+
+    };
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+}
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "SemVersion.h"
+
+namespace sts {
+namespace semver {
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    /*!
+     * \details Represents version range (constraint).
+     * \details Grammar:
+     * \code
+     *     range      ::= set ( '||' set )*
+     *     set        ::= '*' | comparator ( ' ' comparator )*
+     *     comparator ::= ( '=' | '<' | '<=' | '>' | '>=' | '^' | '~' )? version
+     * \endcode
+     * \details The comparators of a set must be satisfied all together,
+     *          a range is satisfied if any of its sets is satisfied.
+     *          An empty set or '*' is satisfied by any version.
+     * \details Versions are compared by \link SemVersion::comparePrecedence \endlink.
+     *          ^1.2.3 means >=1.2.3 <2.0.0-0, ^0.2.3 means >=0.2.3 <0.3.0-0, ^0.0.3 means >=0.0.3 <0.0.4-0.
+     *          ~1.2.3 means >=1.2.3 <1.3.0-0.
+     *          The '-0' suffix excludes pre-releases of the upper bound.
+     */
+    class Range {
+    public:
+
+        enum class Operation : std::uint8_t {
+            Equal,
+            Less,
+            LessOrEqual,
+            Greater,
+            GreaterOrEqual,
+        };
+
+        struct Comparator {
+            Operation mOperation;
+            SemVersion mVersion;
+
+            /*!
+             * \return True if the version satisfies the comparator.
+             */
+            SemVerExp bool test(const SemVersion & version) const STS_SEMVER_NOEXCEPT;
+
+            /*!
+             * \param [in] precedence result of comparing the checked version with mVersion by the precedence:
+             *                        negative, 0 or positive, see \link SemVersion::comparePrecedence \endlink.
+             * \return True if the comparison result satisfies the operation.
+             */
+            SemVerExp bool testPrecedence(int precedence) const STS_SEMVER_NOEXCEPT;
+        };
+
+        typedef std::vector<Comparator> ComparatorSet;
+
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \details Checks whether the range is valid.
+         *          Invalid range hasn't got any comparator set and isn't satisfied by any version.
+         */
+        operator bool() const {
+            return !mSets.empty();
+        }
+
+        /*!
+         * \return True if the version satisfies the range.
+         */
+        SemVerExp bool contains(const SemVersion & version) const STS_SEMVER_NOEXCEPT;
+
+        /*!
+         * \details Checks the range for a version which isn't a SemVersion object.
+         * \param [in] compare it is called with the version of each checked comparator and must return
+         *                     the precedence comparison of the checked version with it, see
+         *                     \link Comparator::testPrecedence \endlink.
+         * \return True if the version satisfies the range.
+         */
+        template<typename Compare>
+        bool containsBy(Compare compare) const {
+            for (auto & set : mSets) {
+                bool res = true;
+                for (auto & comparator : set) {
+                    if (!comparator.testPrecedence(compare(comparator.mVersion))) {
+                        res = false;
+                        break;
+                    }
+                }
+                if (res) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \details Parses string.
+         * \param [in] range pointer to the string, it doesn't need to be null-terminated.
+         * \param [in] length length of the string in bytes.
+         * \return valid Range if successful otherwise invalid.
+         */
+        SemVerExp static Range parse(const char * range, std::size_t length);
+
+        /*!
+         * \details Parses null-terminated string.
+         * \param [in] range
+         * \return valid Range if successful otherwise invalid.
+         */
+        static Range parse(const char * range) {
+            return range ? parse(range, std::strlen(range)) : Range();
+        }
+
+        /*!
+         * \details Parses string.
+         * \param [in] range
+         * \return valid Range if successful otherwise invalid.
+         */
+        static Range parse(const std::string & range) {
+            return parse(range.data(), range.length());
+        }
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        std::vector<ComparatorSet> mSets;
+
+        // @}
+        //---------------------------------------------------------------
+
+    };
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+}
+}
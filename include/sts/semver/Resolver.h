@@ -0,0 +1,170 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "SemVersion.h"
+
+namespace sts {
+namespace semver {
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    /*!
+     * \details Requirement of a package.
+     */
+    struct Dependency {
+        std::string mPackage;
+        /*! \details \link Range \endlink string, an invalid range isn't satisfied by any version. */
+        std::string mRange;
+    };
+
+    /*!
+     * \details Source of the packages information for the \link Resolver \endlink.
+     */
+    class Provider {
+    public:
+
+        virtual ~Provider() = default;
+
+        /*!
+         * \return All the available versions of the package, empty if the package is unknown.
+         */
+        virtual std::vector<SemVersion> versions(const std::string & package) = 0;
+
+        /*!
+         * \return Dependencies of the package version.
+         */
+        virtual std::vector<Dependency> dependencies(const std::string & package, const SemVersion & version) = 0;
+
+    };
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    /*!
+     * \details Provider which keeps everything in memory.
+     */
+    class MemoryProvider : public Provider {
+    public:
+
+        /*!
+         * \details Adds the package version, the existing one is replaced.
+         * \param [in] package
+         * \param [in] version
+         * \param [in] dependencies
+         */
+        SemVerExp void add(const std::string & package, const SemVersion & version,
+                           const std::vector<Dependency> & dependencies);
+
+        SemVerExp std::vector<SemVersion> versions(const std::string & package) override;
+        SemVerExp std::vector<Dependency> dependencies(const std::string & package, const SemVersion & version) override;
+
+    private:
+
+        struct Item {
+            SemVersion mVersion;
+            std::vector<Dependency> mDependencies;
+        };
+
+        std::unordered_map<std::string, std::vector<Item>> mPackages;
+
+    };
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    /*!
+     * \details Finds one version for each required package so all the dependencies are satisfied.
+     * \details The newest versions are tried first. When a package can't get any version the resolver
+     *          jumps back directly to the latest decision which caused the conflict (not just the previous one)
+     *          and remembers the conflicting combination of versions so it is never tried again.
+     *          The remembered combinations cover all the versions which give the same conflict,
+     *          e.g. the versions with the same dependencies, so they aren't tried one by one.
+     *          The packages with the fewest candidates are decided first.
+     *          Intersections of the constraints are cached by the target package ranges.
+     * \details If the requirements can't be satisfied the conflict is explained with a minimal set
+     *          of the dependencies which still can't be satisfied together (removing any of them resolves it).
+     */
+    class Resolver {
+    public:
+
+        struct Result {
+            /*! \details True if all the requirements are satisfied. */
+            bool mResolved = false;
+            /*! \details Package name -> selected version. */
+            std::map<std::string, SemVersion> mVersions;
+            /*! \details Human readable explanation of the conflict if the resolving failed. */
+            std::vector<std::string> mConflict;
+            /*! \details Number of the tried package versions, it is useful for profiling. */
+            std::size_t mAttempts = 0;
+        };
+
+        //---------------------------------------------------------------
+        // @{
+
+        explicit Resolver(Provider & provider)
+            : mProvider(provider) {}
+
+        Resolver(const Resolver &) = delete;
+        Resolver & operator=(const Resolver &) = delete;
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \param [in] requirements root requirements.
+         * \return Resolving result.
+         */
+        SemVerExp Result resolve(const std::vector<Dependency> & requirements);
+
+        // @}
+        //---------------------------------------------------------------
+
+    private:
+
+        Provider & mProvider;
+
+    };
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+}
+}
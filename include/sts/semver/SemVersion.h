@@ -31,6 +31,8 @@
 
 #include <string>
 #include <cstdint>
+#include <cstddef>
+#include <cstring>
 #include <tuple>
 #include <regex>
 #include "Export.h"
@@ -102,6 +104,14 @@ namespace semver {
               mPreRelease(preRelease),
               mBuild(build) {}
 
+        SemVersion(const uint major, const uint minor, const uint patch,
+                   std::string && preRelease, std::string && build)
+            : mMajor(major),
+              mMinor(minor),
+              mPatch(patch),
+              mPreRelease(std::move(preRelease)),
+              mBuild(std::move(build)) {}
+
         ~SemVersion() = default;
 
         // @}
@@ -146,6 +156,17 @@ namespace semver {
          */
         SemVerExp bool compare(const SemVersion & other, bool preRelease = false, bool build = false) const;
 
+        /*!
+         * \details Compares precedence of the versions according to the semver.org (section 11).
+         *          Pre-release version has lower precedence than the normal one,
+         *          pre-release identifiers are compared one by one, numeric identifiers are compared numerically.
+         *          The build part is ignored.
+         * \param [in] other
+         * \return Negative value if this version has lower precedence, 0 if the precedence is equal,
+         *         positive value if this version has higher precedence.
+         */
+        SemVerExp int comparePrecedence(const SemVersion & other) const STS_SEMVER_NOEXCEPT;
+
         /*!
          * \note It compares only major minor and patch parts.
          * \see \link SemVersion::compare \endlink
@@ -222,13 +243,29 @@ namespace semver {
          */
         void set(const uint major, const uint minor, const uint patch,
                  const char * preRelease, const char * build) {
-            set(major, minor, patch);
-            if (preRelease) {
-                mPreRelease.append(preRelease);
-            }
-            if (build) {
-                mBuild.append(build);
-            }
+            set(major, minor, patch,
+                preRelease, preRelease ? std::strlen(preRelease) : 0,
+                build, build ? std::strlen(build) : 0);
+        }
+
+        /*!
+         * \details Sets new values, the existing capacity of the strings is reused.
+         * \param [in] major 
+         * \param [in] minor 
+         * \param [in] patch 
+         * \param [in] preRelease it may be nullptr if the length is 0.
+         * \param [in] preReleaseLength
+         * \param [in] build it may be nullptr if the length is 0.
+         * \param [in] buildLength
+         */
+        void set(const uint major, const uint minor, const uint patch,
+                 const char * preRelease, const std::size_t preReleaseLength,
+                 const char * build, const std::size_t buildLength) {
+            mMajor = major;
+            mMinor = minor;
+            mPatch = patch;
+            mPreRelease.assign(preRelease ? preRelease : "", preReleaseLength);
+            mBuild.assign(build ? build : "", buildLength);
         }
 
         /*!
@@ -241,11 +278,83 @@ namespace semver {
          */
         void set(const uint major, const uint minor, const uint patch,
                  const std::string & preRelease, const std::string & build) {
-            set(major, minor, patch);
+            mMajor = major;
+            mMinor = minor;
+            mPatch = patch;
             mPreRelease = preRelease;
             mBuild = build;
         }
 
+        /*!
+         * \details Sets new values, the strings are moved.
+         * \param [in] major 
+         * \param [in] minor 
+         * \param [in] patch 
+         * \param [in] preRelease 
+         * \param [in] build 
+         */
+        void set(const uint major, const uint minor, const uint patch,
+                 std::string && preRelease, std::string && build) {
+            mMajor = major;
+            mMinor = minor;
+            mPatch = patch;
+            mPreRelease = std::move(preRelease);
+            mBuild = std::move(build);
+        }
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \details Increments major and resets minor and patch to 0.
+         *          Pre release and build values are cleaned, their capacity is kept.
+         * \return False if major is already UINT32_MAX, the version isn't changed then.
+         */
+        bool bumpMajor() {
+            if (mMajor == UINT32_MAX) {
+                return false;
+            }
+            set(mMajor + 1, 0, 0);
+            return true;
+        }
+
+        /*!
+         * \details Increments minor and resets patch to 0.
+         *          Pre release and build values are cleaned, their capacity is kept.
+         * \return False if minor is already UINT32_MAX, the version isn't changed then.
+         */
+        bool bumpMinor() {
+            if (mMinor == UINT32_MAX) {
+                return false;
+            }
+            set(mMajor, mMinor + 1, 0);
+            return true;
+        }
+
+        /*!
+         * \details Increments patch.
+         *          Pre release and build values are cleaned, their capacity is kept.
+         * \return False if patch is already UINT32_MAX, the version isn't changed then.
+         */
+        bool bumpPatch() {
+            if (mPatch == UINT32_MAX) {
+                return false;
+            }
+            set(mMajor, mMinor, mPatch + 1);
+            return true;
+        }
+
+        /*!
+         * \details Increments the last numeric identifier of the pre release value in place,
+         *          the build value is cleaned.
+         * \details rc.9 -> rc.10, beta -> beta.0,
+         *          a version without pre release gets next patch: 1.2.3 -> 1.2.4-0.
+         * \return False if the version is without pre release and patch is already UINT32_MAX,
+         *         the version isn't changed then.
+         */
+        SemVerExp bool bumpPreRelease();
+
         // @}
         //---------------------------------------------------------------
         // @{
@@ -263,9 +372,34 @@ namespace semver {
          * \link SemVersion::operator bool() const \endlink
          */
         static SemVersion parse(const char * version) {
-            return version ? parse(std::string(version)) : SemVersion();
+            return version ? parse(version, std::strlen(version)) : SemVersion();
+        }
+
+        /*!
+         * \details Parses string.
+         * \param [in] version pointer to the string, it doesn't need to be null-terminated.
+         * \param [in] length length of the string in bytes.
+         * \return valid SemVersion if successful otherwise invalid.
+         *         It is also invalid if a number doesn't fit 32 bits.
+         * \link SemVersion::operator bool() const \endlink
+         */
+        static SemVersion parse(const char * version, const std::size_t length) {
+            SemVersion res;
+            parse(version, length, res);
+            return res;
         }
 
+        /*!
+         * \details Parses string into existing object, the capacity of its strings is reused.
+         * \details Unlike the operator bool, the result tells whether the string is valid,
+         *          so "0.0.0" is successfully parsed.
+         * \param [in] version pointer to the string, it doesn't need to be null-terminated.
+         * \param [in] length length of the string in bytes.
+         * \param [out] outVersion parsed version or cleared one if the string isn't valid.
+         * \return True if the string is valid otherwise false.
+         */
+        SemVerExp static bool parse(const char * version, std::size_t length, SemVersion & outVersion);
+
         /*!
          * \details Parses string.
          * \param [in] version
@@ -284,6 +418,112 @@ namespace semver {
         //---------------------------------------------------------------
         // @{
 
+        /*!
+         * \details Flags of the lenient parsing, they can be combined.
+         */
+        enum Leniency : std::uint8_t {
+            LenientNone = 0,
+            /*! \details "v" or "=" prefix e.g. "v1.2.3", "=1.2.3" or "=v1.2.3". */
+            LenientPrefix = 1 << 0,
+            /*! \details Missing minor and patch numbers e.g. "1", they are set to 0.
+             *           It doesn't allow "1.2", that needs LenientMissingPatch. */
+            LenientMissingMinor = 1 << 1,
+            /*! \details Missing patch number e.g. "1.2", it is set to 0. */
+            LenientMissingPatch = 1 << 2,
+            /*! \details Leading and trailing spaces, tabs and line breaks. */
+            LenientWhitespace = 1 << 3,
+            LenientAll = LenientPrefix | LenientMissingMinor | LenientMissingPatch | LenientWhitespace,
+        };
+
+        /*!
+         * \details Parses string which may be not strictly valid, e.g. " v1.2-beta ".
+         *          The string is checked in the same single pass as \link SemVersion::parse \endlink does
+         *          so it isn't needed to normalize it before.
+         * \details The numbers still must not have leading zeros and the tags must be valid.
+         * \param [in] version pointer to the string, it doesn't need to be null-terminated.
+         * \param [in] length length of the string in bytes.
+         * \param [out] outVersion parsed version or cleared one if the string isn't valid.
+         * \param [in] allowed combination of \link SemVersion::Leniency \endlink flags which are allowed.
+         * \param [out] outApplied the flags which were needed to parse the string, 0 if the string isn't valid.
+         *                         It can be nullptr.
+         * \return True if the string is valid otherwise false.
+         * \code
+         *     SemVersion ver;
+         *     std::uint8_t applied;
+         *     if (SemVersion::parseLenient(str, len, ver, SemVersion::LenientAll, &applied)) {
+         *         if (applied & SemVersion::LenientPrefix) {
+         *             ... // the string had "v" or "=" prefix
+         *         }
+         *     }
+         * \endcode
+         */
+        SemVerExp static bool parseLenient(const char * version, std::size_t length, SemVersion & outVersion,
+                                           std::uint8_t allowed = LenientAll, std::uint8_t * outApplied = nullptr);
+
+        /*!
+         * \details Parses string which may be not strictly valid.
+         * \param [in] version
+         * \param [in] allowed combination of \link SemVersion::Leniency \endlink flags which are allowed.
+         * \param [out] outApplied the flags which were needed to parse the string, it can be nullptr.
+         * \return valid SemVersion if successful otherwise invalid.
+         * \see \link SemVersion::parseLenient(const char *, std::size_t, SemVersion &, std::uint8_t, std::uint8_t *) \endlink
+         */
+        static SemVersion parseLenient(const std::string & version, const std::uint8_t allowed = LenientAll,
+                                       std::uint8_t * outApplied = nullptr) {
+            SemVersion res;
+            parseLenient(version.data(), version.length(), res, allowed, outApplied);
+            return res;
+        }
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \details Checks whether the string matches the Semantic Versioning grammar
+         *          without making any SemVersion and without allocations.
+         * \details Accepts the same strings as \link SemVersion::parse \endlink does
+         *          except it doesn't check whether the numbers fit 32 bits.
+         *          Unlike the operator bool, "0.0.0" is considered as valid.
+         * \param [in] version pointer to the string, it doesn't need to be null-terminated.
+         * \param [in] length length of the string in bytes.
+         * \return True if the string is a valid version otherwise false.
+         */
+        SemVerExp static bool isValid(const char * version, std::size_t length) STS_SEMVER_NOEXCEPT;
+
+        /*!
+         * \details Checks whether the null-terminated string is a valid version.
+         * \param [in] version
+         * \see \link SemVersion::isValid(const char *, std::size_t) \endlink
+         */
+        static bool isValid(const char * version) STS_SEMVER_NOEXCEPT {
+            return version ? isValid(version, std::strlen(version)) : false;
+        }
+
+        /*!
+         * \details Checks whether the string is a valid version.
+         * \param [in] version
+         * \see \link SemVersion::isValid(const char *, std::size_t) \endlink
+         */
+        static bool isValid(const std::string & version) STS_SEMVER_NOEXCEPT {
+            return isValid(version.data(), version.length());
+        }
+
+        /*!
+         * \details Checks many strings at once.
+         * \param [in] versions array of strings, null items are considered as invalid.
+         * \param [in] lengths array of string lengths or nullptr if the strings are null-terminated.
+         * \param [out] outResults array for the results or nullptr if only the count is needed.
+         * \param [in] count number of the items in the arrays.
+         * \return Number of the valid strings.
+         */
+        SemVerExp static std::size_t isValidBatch(const char * const * versions, const std::size_t * lengths,
+                                                  bool * outResults, std::size_t count) STS_SEMVER_NOEXCEPT;
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
         /*!
          * \details Makes string from the values.
          * \param [in] preRelease add 'pre release' value if true.
@@ -318,7 +558,10 @@ namespace semver {
 
     private:
 
-        SemVerExp static const std::regex mRegex;
+        /*!
+         * \deprecated It isn't used by the parser anymore, it is kept for the binary compatibility.
+         */
+        SemVerExp SemVerDeprecated static const std::regex mRegex;
 
     };
 
@@ -0,0 +1,114 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <functional>
+#include "SemVersion.h"
+#include "VersionStats.h"
+
+namespace sts {
+namespace semver {
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    /*!
+     * \details Multi-threaded parse/filter/aggregate pipeline for big version logs.
+     * \details The input is cut into chunks on whitespace boundaries by the calling thread,
+     *          the chunks go through a bounded queue to the worker threads.
+     *          Each worker parses its chunks with own \link StreamParser \endlink
+     *          into own \link VersionStats \endlink, they are merged when the input is over.
+     *          So the workers don't share any lock except the queue one which is taken once per chunk.
+     * \details The versions in the input must be separated by whitespace characters.
+     */
+    class StatsPipeline {
+    public:
+
+        /*!
+         * \details Fills the buffer with next portion of the input.
+         *          It must return number of the written bytes, 0 means the end of the input.
+         */
+        typedef std::function<std::size_t(char * buffer, std::size_t size)> Reader;
+
+        /*!
+         * \details Returns true if the version must be added to the statistics.
+         *          It is called from the worker threads concurrently.
+         */
+        typedef std::function<bool(const SemVersion &)> Filter;
+
+        struct Config {
+            /*! \details Number of the worker threads, 0 means number of the hardware threads. */
+            std::size_t mThreads = 0;
+            /*! \details Size of one chunk in bytes, a token which is longer than a chunk is counted as invalid. */
+            std::size_t mChunkSize = 1024 * 1024;
+            /*! \details Max number of the chunks waiting for processing, 0 means twice the number of the threads. */
+            std::size_t mQueueSize = 0;
+            /*! \details See \link StreamParser::StreamParser \endlink */
+            std::size_t mMaxTagLength = 256;
+            /*! \details Optional filter. */
+            Filter mFilter;
+        };
+
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \details Processes the input which is read with the reader.
+         *          The memory usage is limited by (queue size + threads + 1) * chunk size.
+         * \details If the reader or the filter throws, the pipeline is stopped without reading the rest
+         *          of the input and the exception is re-thrown from this function.
+         * \param [in] reader it is called from the calling thread only.
+         * \param [in] config
+         * \return Merged statistics.
+         */
+        SemVerExp static VersionStats run(const Reader & reader, const Config & config);
+
+        /*!
+         * \details Processes the input which is already in memory, for example a mapped file.
+         *          The data isn't copied, the workers get the slices of it.
+         * \param [in] data
+         * \param [in] length
+         * \param [in] config
+         * \return Merged statistics.
+         */
+        SemVerExp static VersionStats run(const char * data, std::size_t length, const Config & config);
+
+        // @}
+        //---------------------------------------------------------------
+
+    };
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+}
+}
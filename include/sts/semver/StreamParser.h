@@ -0,0 +1,161 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "SemVersion.h"
+
+namespace sts {
+namespace semver {
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    /*!
+     * \details Push-style incremental parser.
+     *          It takes the input by chunks of any size, a version may be split
+     *          between the chunks, and calls the callback for each parsed version.
+     * \details The versions in the input must be separated by whitespace characters.
+     *          The tokens which don't match the grammar of \link SemVersion::parse \endlink are skipped
+     *          and counted, see \link StreamParser::invalidCount \endlink.
+     * \details Memory usage doesn't depend on the input size, a pre-release or build tag
+     *          which is longer than the limit makes the token invalid.
+     * \code
+     *     StreamParser parser([](const SemVersion & v) { ... });
+     *     while (read(buffer, size)) {
+     *         parser.feed(buffer, size);
+     *     }
+     *     parser.finish();
+     * \endcode
+     */
+    class StreamParser {
+    public:
+
+        typedef std::function<void(const SemVersion &)> Callback;
+
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \param [in] callback it is called for each parsed version.
+         *                      The version object is reused by the parser so copy it if you need it later.
+         * \param [in] maxTagLength max length of the pre-release and build tags.
+         */
+        SemVerExp explicit StreamParser(Callback callback, std::size_t maxTagLength = 256);
+
+        StreamParser(const StreamParser &) = delete;
+        StreamParser & operator=(const StreamParser &) = delete;
+
+        ~StreamParser() = default;
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \details Processes next chunk of the input.
+         * \param [in] data
+         * \param [in] length
+         * \return Number of the versions which were passed to the callback while processing this chunk.
+         */
+        SemVerExp std::size_t feed(const char * data, std::size_t length);
+
+        /*!
+         * \details Processes the end of the input,
+         *          the last version doesn't need a trailing whitespace.
+         *          After this call the parser is ready for a new input.
+         * \return 1 if a version was passed to the callback otherwise 0.
+         */
+        SemVerExp std::size_t finish();
+
+        /*!
+         * \details Drops a partially parsed version and the counters.
+         */
+        SemVerExp void reset();
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \return Number of the versions passed to the callback since the last reset.
+         */
+        std::size_t parsedCount() const {
+            return mParsedCount;
+        }
+
+        /*!
+         * \return Number of the skipped invalid tokens since the last reset.
+         */
+        std::size_t invalidCount() const {
+            return mInvalidCount;
+        }
+
+        // @}
+        //---------------------------------------------------------------
+
+    private:
+
+        enum class State : std::uint8_t {
+            Delimiter,
+            Major,
+            Minor,
+            Patch,
+            PreReleaseFirst,
+            PreRelease,
+            BuildFirst,
+            Build,
+            Skip,
+        };
+
+        bool pushDigit(char ch);
+        bool endNumber(std::uint32_t & outValue);
+        void emit();
+        void invalidate(bool delimiterReached);
+
+        Callback mCallback;
+        std::size_t mMaxTagLength;
+        SemVersion mVersion;
+        std::uint64_t mNumber = 0;
+        std::size_t mDigits = 0;
+        std::size_t mParsedCount = 0;
+        std::size_t mInvalidCount = 0;
+        State mState = State::Delimiter;
+
+    };
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+}
+}
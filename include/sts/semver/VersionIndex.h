@@ -0,0 +1,261 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SemVersion.h"
+#include "Range.h"
+
+namespace sts {
+namespace semver {
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    /*!
+     * \details Read-only view of a serialized version index.
+     * \details The index is built once with \link VersionIndex::build \endlink or \link VersionIndex::write \endlink
+     *          and then it can be used directly from any memory, e.g. a file mapped by many processes
+     *          with \link VersionIndexFile \endlink. The format has only offsets and no pointers
+     *          so it doesn't depend on the address where it is loaded.
+     * \details Format (native byte order, it is checked when the index is opened):
+     * \code
+     *     header  : magic "STSSVIDX", format version, byte order mark, file size, versions count,
+     *               entries offset, strings offset, strings size, FNV-1a 64 checksum of the data after the header
+     *     entries : major, minor, patch, pre-release offset and length, build offset and length (uint32 each)
+     *     strings : the unique pre-release and build values without separators
+     * \endcode
+     * \details The entries are sorted by \link SemVersion::comparePrecedence \endlink
+     *          (versions with equal precedence are ordered by the pre-release and the build bytes).
+     *          The queries don't allocate memory except the ones which return \link SemVersion \endlink.
+     * \note The view doesn't own the memory, it must outlive the view.
+     */
+    class VersionIndex {
+    public:
+
+        /*! \details Version of the format which is written by this library. */
+        static const std::uint32_t FormatVersion = 1;
+
+        /*! \details Is returned if nothing is found. */
+        static const std::size_t npos = static_cast<std::size_t>(-1);
+
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \details Creates invalid index.
+         */
+        VersionIndex() = default;
+
+        /*!
+         * \details Opens the index from memory, the header and the bounds of all the entries are checked.
+         * \param [in] data pointer to the serialized index.
+         * \param [in] size size of the data in bytes.
+         * \param [in] verifyChecksum the checksum is calculated for the whole data, it may be skipped
+         *                            if the data is known to be correct, e.g. it has been checked by another process.
+         * \note Check result with \link VersionIndex::isValid \endlink.
+         */
+        SemVerExp VersionIndex(const void * data, std::size_t size, bool verifyChecksum = true);
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \details Checks whether the index has been opened successfully.
+         */
+        bool isValid() const {
+            return mEntries != nullptr;
+        }
+
+        std::size_t size() const {
+            return mCount;
+        }
+
+        bool empty() const {
+            return mCount == 0;
+        }
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \param [in] index must be less than size.
+         * \return The version at the position.
+         */
+        SemVersion version(const std::size_t index) const {
+            SemVersion res;
+            version(index, res);
+            return res;
+        }
+
+        /*!
+         * \details Sets the version at the position into the existing object, its string capacity is reused.
+         * \param [in] index must be less than size.
+         * \param [out] outVersion
+         */
+        SemVerExp void version(std::size_t index, SemVersion & outVersion) const;
+
+        /*!
+         * \details Finds the version, all the parts including build are compared.
+         * \param [in] version
+         * \return Position of the version or npos.
+         */
+        SemVerExp std::size_t find(const SemVersion & version) const STS_SEMVER_NOEXCEPT;
+
+        /*!
+         * \param [in] version
+         * \return Position of the first version which has precedence not lower than the given one
+         *         or size if there isn't such version.
+         */
+        SemVerExp std::size_t lowerBound(const SemVersion & version) const STS_SEMVER_NOEXCEPT;
+
+        /*!
+         * \param [in] version
+         * \return Position of the first version which has precedence higher than the given one
+         *         or size if there isn't such version.
+         */
+        SemVerExp std::size_t upperBound(const SemVersion & version) const STS_SEMVER_NOEXCEPT;
+
+        /*!
+         * \details Each comparator set of the range is a continuous interval of the sorted versions
+         *          so the search needs only binary searches.
+         * \param [in] range
+         * \return Position of the highest version which satisfies the range or npos.
+         */
+        SemVerExp std::size_t maxSatisfying(const Range & range) const STS_SEMVER_NOEXCEPT;
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \details Serializes the versions.
+         * \param [in] versions any order, duplicates are removed.
+         * \return Serialized index.
+         */
+        SemVerExp static std::vector<std::uint8_t> build(const std::vector<SemVersion> & versions);
+
+        /*!
+         * \details Serializes the versions into the file.
+         *          The data is written to a uniquely named temporary file and flushed to the disk first,
+         *          then the file replaces the target one. So the processes which have mapped the previous file
+         *          aren't affected, concurrent writers don't corrupt each other and after a crash
+         *          the target is either the previous or the new complete index.
+         * \param [in] versions any order, duplicates are removed.
+         * \param [in] path
+         * \return True if successful otherwise false.
+         */
+        SemVerExp static bool write(const std::vector<SemVersion> & versions, const std::string & path);
+
+        // @}
+        //---------------------------------------------------------------
+
+    private:
+
+        int comparePrecedence(std::size_t index, const SemVersion & version) const STS_SEMVER_NOEXCEPT;
+
+        const std::uint8_t * mEntries = nullptr;
+        const char * mStrings = nullptr;
+        std::size_t mCount = 0;
+
+    };
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    /*!
+     * \details Read-only mapping of a version index file.
+     *          The operating system shares the pages between all the processes which map the same file.
+     */
+    class VersionIndexFile {
+    public:
+
+        //---------------------------------------------------------------
+        // @{
+
+        VersionIndexFile() = default;
+        VersionIndexFile(const VersionIndexFile &) = delete;
+        VersionIndexFile & operator=(const VersionIndexFile &) = delete;
+
+        ~VersionIndexFile() {
+            close();
+        }
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \details Maps the file, the previous one is closed.
+         * \param [in] path
+         * \param [in] verifyChecksum see \link VersionIndex::VersionIndex \endlink.
+         * \return True if the file is mapped and the index is valid otherwise false.
+         */
+        SemVerExp bool open(const std::string & path, bool verifyChecksum = true);
+
+        /*!
+         * \details Unmaps the file, the index becomes invalid.
+         */
+        SemVerExp void close();
+
+        /*!
+         * \return The index of the mapped file, invalid if no file is mapped.
+         */
+        const VersionIndex & index() const {
+            return mIndex;
+        }
+
+        // @}
+        //---------------------------------------------------------------
+
+    private:
+
+        VersionIndex mIndex;
+        void * mData = nullptr;
+        std::size_t mSize = 0;
+#ifdef _WIN32
+        void * mFile = nullptr;
+        void * mMapping = nullptr;
+#endif
+
+    };
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+}
+}
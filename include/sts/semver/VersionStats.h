@@ -0,0 +1,104 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include "SemVersion.h"
+
+namespace sts {
+namespace semver {
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    /*!
+     * \details Version adoption statistics.
+     * \details It isn't thread safe, use one object per thread
+     *          and \link VersionStats::merge \endlink them at the end.
+     */
+    class VersionStats {
+    public:
+
+        typedef std::map<std::uint32_t, std::size_t> MajorCounts;
+        typedef std::map<std::pair<std::uint32_t, std::uint32_t>, std::size_t> MinorCounts;
+
+        //---------------------------------------------------------------
+        // @{
+
+        /*!
+         * \details Adds the version to the statistics.
+         * \param [in] version
+         */
+        SemVerExp void add(const SemVersion & version);
+
+        /*!
+         * \details Adds the other statistics to this one.
+         * \param [in] other
+         */
+        SemVerExp void merge(const VersionStats & other);
+
+        /*!
+         * \return Share of the pre-release versions in range [0, 1].
+         */
+        double preReleaseShare() const {
+            return mTotal != 0 ? static_cast<double>(mPreReleaseCount) / static_cast<double>(mTotal) : 0.0;
+        }
+
+        // @}
+        //---------------------------------------------------------------
+        // @{
+
+        /*! \details Number of the added versions. */
+        std::size_t mTotal = 0;
+        /*! \details Number of the added versions which have pre-release part. */
+        std::size_t mPreReleaseCount = 0;
+        /*! \details Number of the invalid tokens, it is filled by the \link StatsPipeline \endlink. */
+        std::size_t mInvalidCount = 0;
+        /*! \details Number of the versions per major. */
+        MajorCounts mMajorCounts;
+        /*! \details Number of the versions per major and minor. */
+        MinorCounts mMinorCounts;
+        /*! \details The version with highest precedence, it makes sense only if mTotal isn't 0. */
+        SemVersion mNewest;
+
+        // @}
+        //---------------------------------------------------------------
+
+    };
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+}
+}
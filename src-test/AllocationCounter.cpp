@@ -0,0 +1,245 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "sts/semver/SemVersion.h"
+#include "AllocationCounter.h"
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Local *////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * The counters are plain atomics which are zero-initialized before any dynamic initialization,
+ * so the allocations of the static objects are counted correctly.
+ */
+
+namespace {
+
+    std::atomic<std::size_t> gAllocations(0);
+    std::atomic<std::size_t> gBytes(0);
+    std::atomic<std::size_t> gDeallocations(0);
+
+    void countAllocation(const std::size_t size) {
+        gAllocations.fetch_add(1, std::memory_order_relaxed);
+        gBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void countDeallocation() {
+        gDeallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+}
+
+#if defined(__GLIBC__)
+
+// The glibc implementation is available with these names, so malloc can be replaced without dlsym.
+extern "C" {
+    void * __libc_malloc(std::size_t size);
+    void * __libc_calloc(std::size_t count, std::size_t size);
+    void * __libc_realloc(void * ptr, std::size_t size);
+    void __libc_free(void * ptr);
+}
+
+namespace {
+
+    void * rawMalloc(const std::size_t size) {
+        return __libc_malloc(size);
+    }
+
+    void rawFree(void * ptr) {
+        __libc_free(ptr);
+    }
+
+}
+
+extern "C" {
+
+    void * malloc(std::size_t size) {
+        countAllocation(size);
+        return __libc_malloc(size);
+    }
+
+    void * calloc(std::size_t count, std::size_t size) {
+        countAllocation(count * size);
+        return __libc_calloc(count, size);
+    }
+
+    void * realloc(void * ptr, std::size_t size) {
+        countAllocation(size);
+        if (ptr) {
+            countDeallocation();
+        }
+        return __libc_realloc(ptr, size);
+    }
+
+    void free(void * ptr) {
+        if (ptr) {
+            countDeallocation();
+        }
+        __libc_free(ptr);
+    }
+
+}
+
+#else
+
+namespace {
+
+    void * rawMalloc(const std::size_t size) {
+        return std::malloc(size);
+    }
+
+    void rawFree(void * ptr) {
+        std::free(ptr);
+    }
+
+}
+
+#endif
+
+/**************************************************************************************************/
+/////////////////////////////////////////* Operators *//////////////////////////////////////////////
+/**************************************************************************************************/
+
+namespace {
+
+    void * allocate(std::size_t size) {
+        if (size == 0) {
+            size = 1;
+        }
+        for (;;) {
+            void * ptr = rawMalloc(size);
+            if (ptr) {
+                countAllocation(size);
+                return ptr;
+            }
+            const std::new_handler handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void deallocate(void * ptr) {
+        if (ptr) {
+            countDeallocation();
+            rawFree(ptr);
+        }
+    }
+
+}
+
+void * operator new(const std::size_t size) {
+    return allocate(size);
+}
+
+void * operator new[](const std::size_t size) {
+    return allocate(size);
+}
+
+void * operator new(const std::size_t size, const std::nothrow_t &) STS_SEMVER_NOEXCEPT {
+    try {
+        return allocate(size);
+    }
+    catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+}
+
+void * operator new[](const std::size_t size, const std::nothrow_t &) STS_SEMVER_NOEXCEPT {
+    try {
+        return allocate(size);
+    }
+    catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+}
+
+void operator delete(void * ptr) STS_SEMVER_NOEXCEPT {
+    deallocate(ptr);
+}
+
+void operator delete[](void * ptr) STS_SEMVER_NOEXCEPT {
+    deallocate(ptr);
+}
+
+void operator delete(void * ptr, const std::nothrow_t &) STS_SEMVER_NOEXCEPT {
+    deallocate(ptr);
+}
+
+void operator delete[](void * ptr, const std::nothrow_t &) STS_SEMVER_NOEXCEPT {
+    deallocate(ptr);
+}
+
+// C++14 sized deallocation, without these ones the library defaults would be used.
+void operator delete(void * ptr, std::size_t) STS_SEMVER_NOEXCEPT {
+    deallocate(ptr);
+}
+
+void operator delete[](void * ptr, std::size_t) STS_SEMVER_NOEXCEPT {
+    deallocate(ptr);
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+AllocationCounter::AllocationCounter()
+    : mAllocations(gAllocations.load()),
+      mBytes(gBytes.load()),
+      mDeallocations(gDeallocations.load()) {}
+
+std::size_t AllocationCounter::allocations() const {
+    return gAllocations.load() - mAllocations;
+}
+
+std::size_t AllocationCounter::bytes() const {
+    return gBytes.load() - mBytes;
+}
+
+std::size_t AllocationCounter::deallocations() const {
+    return gDeallocations.load() - mDeallocations;
+}
+
+bool AllocationCounter::isMallocTracked() {
+#if defined(__GLIBC__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,110 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+
+#include <cstddef>
+#include "gtest/gtest.h"
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Counts heap allocations of the current process while the object is alive.
+ * \details The test executable replaces the global operator new/delete,
+ *          with glibc malloc, calloc, realloc and free are replaced too.
+ *          The objects can be nested, each one counts since its creation.
+ * \note Allocations of all the threads are counted, so the other threads must not work in the scope.
+ * \note On Windows the allocations inside the library are counted only if it is linked statically.
+ * \note posix_memalign and aligned_alloc aren't replaced, but free counts their deallocations,
+ *       so the deallocations may exceed the allocations if they are used in the scope.
+ */
+class AllocationCounter {
+public:
+
+    AllocationCounter();
+
+    AllocationCounter(const AllocationCounter &) = delete;
+    AllocationCounter & operator=(const AllocationCounter &) = delete;
+
+    /*!
+     * \return Number of the allocations by operator new and the malloc functions since the object creation.
+     */
+    std::size_t allocations() const;
+
+    /*!
+     * \return Number of the requested bytes since the object creation.
+     */
+    std::size_t bytes() const;
+
+    /*!
+     * \return Number of the deallocations since the object creation.
+     */
+    std::size_t deallocations() const;
+
+    /*!
+     * \return True if the malloc functions are replaced on this platform.
+     */
+    static bool isMallocTracked();
+
+private:
+
+    std::size_t mAllocations;
+    std::size_t mBytes;
+    std::size_t mDeallocations;
+
+};
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*!
+ * \details Asserts that the statement makes not more than the budget allocations.
+ *          The statement should keep its result, e.g. assign it to a variable declared outside,
+ *          otherwise the compiler may remove it.
+ */
+#define ASSERT_ALLOCATIONS_LE(budget, statement) \
+    do { \
+        const AllocationCounter allocationCounter_; \
+        statement; \
+        const std::size_t allocations_ = allocationCounter_.allocations(); \
+        ASSERT_LE(allocations_, static_cast<std::size_t>(budget)) << #statement; \
+    } while (false)
+
+/*!
+ * \details Asserts that the statement doesn't allocate memory.
+ */
+#define ASSERT_NO_ALLOCATIONS(statement) ASSERT_ALLOCATIONS_LE(0, statement)
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
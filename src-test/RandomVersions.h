@@ -0,0 +1,92 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "sts/semver/SemVersion.h"
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * Random versions for the tests of the version containers.
+ * The numbers are small and the tags are picked from short lists, so there are many duplicates.
+ */
+
+inline sts::semver::SemVersion randomVersion(std::mt19937 & rnd) {
+    const char * preReleases[] = {"", "", "", "alpha", "alpha.1", "beta", "beta.2", "beta.11", "rc.1", "rc.01"};
+    const char * builds[] = {"", "", "", "", "build.1", "build.2", "sha.5114f85"};
+    return sts::semver::SemVersion(rnd() % 5, rnd() % 20, rnd() % 100,
+                                   preReleases[rnd() % (sizeof(preReleases) / sizeof(preReleases[0]))],
+                                   builds[rnd() % (sizeof(builds) / sizeof(builds[0]))]);
+}
+
+inline std::vector<sts::semver::SemVersion> randomVersions(const std::size_t count, const unsigned seed = 42) {
+    std::mt19937 rnd(seed);
+    std::vector<sts::semver::SemVersion> res;
+    res.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        res.push_back(randomVersion(rnd));
+    }
+    return res;
+}
+
+/*
+ * Total order: precedence, then the pre-release and build strings,
+ * so the versions which have the same precedence but different text aren't equal.
+ */
+inline bool lessVersion(const sts::semver::SemVersion & l, const sts::semver::SemVersion & r) {
+    const int res = l.comparePrecedence(r);
+    if (res != 0) {
+        return res < 0;
+    }
+    if (l.mPreRelease != r.mPreRelease) {
+        return l.mPreRelease < r.mPreRelease;
+    }
+    return l.mBuild < r.mBuild;
+}
+
+inline bool equalVersion(const sts::semver::SemVersion & l, const sts::semver::SemVersion & r) {
+    return l.compare(r, true, true);
+}
+
+inline std::vector<sts::semver::SemVersion> sortedUnique(std::vector<sts::semver::SemVersion> versions) {
+    std::sort(versions.begin(), versions.end(), lessVersion);
+    versions.erase(std::unique(versions.begin(), versions.end(), equalVersion), versions.end());
+    return versions;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
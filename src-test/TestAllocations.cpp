@@ -0,0 +1,224 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "sts/semver/CApi.h"
+#include "sts/semver/CompactVersionSet.h"
+#include "sts/semver/Range.h"
+#include "sts/semver/SemVersion.h"
+#include "sts/semver/StreamParser.h"
+#include "sts/semver/VersionIndex.h"
+#include "sts/semver/VersionStats.h"
+#include "AllocationCounter.h"
+
+using namespace sts::semver;
+
+/*
+ * Allocation budgets of the hot paths, a failure means the function allocates more than before.
+ * The budgets are for the short tags which fit into the small string buffer (15 characters with libstdc++ and MSVC).
+ */
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(Allocations, counter) {
+    void * volatile ptr = nullptr;
+    const AllocationCounter counter;
+    {
+        const AllocationCounter nested;
+        ptr = ::operator new(100);
+        ASSERT_EQ(1, nested.allocations());
+        ASSERT_EQ(100, nested.bytes());
+    }
+    ::operator delete(ptr);
+    ASSERT_EQ(1, counter.allocations());
+    ASSERT_EQ(1, counter.deallocations());
+    if (AllocationCounter::isMallocTracked()) {
+        ptr = std::malloc(10);
+        std::free(ptr);
+        ASSERT_EQ(2, counter.allocations());
+    }
+}
+
+TEST(Allocations, semversion_parse) {
+    SemVersion version;
+    bool res = false;
+    ASSERT_NO_ALLOCATIONS(version = SemVersion::parse("1.2.3"));
+    ASSERT_NO_ALLOCATIONS(version = SemVersion::parse("4294967295.0.99"));
+    ASSERT_NO_ALLOCATIONS(version = SemVersion::parse("1.2.3-rc.1+build.5"));
+    ASSERT_NO_ALLOCATIONS(version = SemVersion::parse("not a version"));
+    // the long tags need their own buffers
+    ASSERT_ALLOCATIONS_LE(2, version = SemVersion::parse("1.2.3-alpha.beta.gamma.delta+build.2018.12.31.sha.5114f85"));
+    // parsing into the existing object reuses its capacity
+    ASSERT_NO_ALLOCATIONS(res = SemVersion::parse("1.2.3-alpha.beta.gamma.epsilon", 30, version));
+    ASSERT_TRUE(res);
+    ASSERT_NO_ALLOCATIONS(res = SemVersion::isValid("1.2.3-alpha.beta.gamma.delta+build.2018.12.31.sha.5114f85"));
+    ASSERT_TRUE(res);
+}
+
+TEST(Allocations, semversion_compare) {
+    const SemVersion left(1, 2, 3, "alpha.beta.gamma.delta", "build.2018.12.31.sha.5114f85");
+    const SemVersion right(1, 2, 3, "alpha.beta.gamma.epsilon", "");
+    int precedence = 0;
+    bool res = false;
+    ASSERT_NO_ALLOCATIONS(precedence = left.comparePrecedence(right));
+    ASSERT_EQ(-1, precedence);
+    ASSERT_NO_ALLOCATIONS(res = left.compare(right, true, true));
+    ASSERT_NO_ALLOCATIONS(res = left == right);
+    ASSERT_NO_ALLOCATIONS(res = left != right);
+    ASSERT_NO_ALLOCATIONS(res = left < right);
+    ASSERT_NO_ALLOCATIONS(res = left <= right);
+    ASSERT_NO_ALLOCATIONS(res = left > right);
+    ASSERT_NO_ALLOCATIONS(res = left >= right);
+    ASSERT_NO_ALLOCATIONS(res = static_cast<bool>(left));
+    (void)res;
+}
+
+TEST(Allocations, semversion_to_string) {
+    const SemVersion version(1, 2, 3, "rc.1", "b.5");
+    const SemVersion longVersion(1, 2, 3, "alpha.beta.gamma.delta", "build.2018.12.31.sha.5114f85");
+    std::string str;
+    ASSERT_NO_ALLOCATIONS(str = version.toString());
+    ASSERT_NO_ALLOCATIONS(str = version.toString(true, true));
+    ASSERT_EQ("1.2.3-rc.1+b.5", str);
+    ASSERT_ALLOCATIONS_LE(1, str = longVersion.toString(true, true));
+}
+
+TEST(Allocations, semversion_modify) {
+    SemVersion version(1, 2, 3, "alpha.beta.gamma.delta", "build.2018.12.31.sha.5114f85");
+    ASSERT_NO_ALLOCATIONS(version.bumpPatch());
+    ASSERT_NO_ALLOCATIONS(version.bumpMinor());
+    ASSERT_NO_ALLOCATIONS(version.bumpMajor());
+    // the tags aren't longer than the previous ones so the capacity is enough
+    ASSERT_NO_ALLOCATIONS(version.set(1, 2, 3, "alpha.beta.gamma.zeta", "build.2019.01.01.sha.5114f85"));
+    // the tag grows
+    ASSERT_ALLOCATIONS_LE(1, version.bumpPreRelease());
+    ASSERT_NO_ALLOCATIONS(version.clear());
+
+    SemVersion shortTag(1, 2, 3, "rc.9", "");
+    ASSERT_NO_ALLOCATIONS(shortTag.bumpPreRelease());
+    ASSERT_EQ("rc.10", shortTag.mPreRelease);
+}
+
+TEST(Allocations, range) {
+    const Range range = Range::parse(">=1.2.3-alpha.beta.gamma.delta <2.0.0 || ^3.1.0");
+    const SemVersion version(1, 5, 0, "alpha.beta.gamma.delta", "");
+    bool res = false;
+    ASSERT_NO_ALLOCATIONS(res = range.contains(version));
+    ASSERT_TRUE(res);
+    Range parsed;
+    // the vectors of the sets and the comparators grow one by one
+    ASSERT_ALLOCATIONS_LE(6, parsed = Range::parse(">=1.2.3 <2.0.0 || ^3.1.0"));
+}
+
+TEST(Allocations, compact_version_set) {
+    std::vector<SemVersion> versions;
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        versions.emplace_back(i % 7, i % 13, i, i % 3 == 0 ? "rc.1" : "", "");
+    }
+    const CompactVersionSet set(versions);
+    const SemVersion version(3, 4, 500, "rc.1", "");
+    bool res = false;
+    CompactVersionSet::Iterator it;
+    ASSERT_NO_ALLOCATIONS(res = set.contains(version));
+    ASSERT_NO_ALLOCATIONS(it = set.lowerBound(version));
+    ASSERT_NO_ALLOCATIONS(it = set.at(500));
+    ASSERT_NO_ALLOCATIONS(++it);
+    (void)res;
+}
+
+TEST(Allocations, version_index) {
+    std::vector<SemVersion> versions;
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        versions.emplace_back(i % 7, i % 13, i, i % 3 == 0 ? "alpha.beta.gamma.delta" : "", "");
+    }
+    const auto data = VersionIndex::build(versions);
+    const VersionIndex index(data.data(), data.size());
+    const SemVersion version(3, 4, 500, "alpha.beta.gamma.delta", "");
+    const Range range = Range::parse("^3.0.0 || <1.0.0");
+    std::size_t res = 0;
+    ASSERT_NO_ALLOCATIONS(res = index.find(version));
+    ASSERT_NO_ALLOCATIONS(res = index.lowerBound(version));
+    ASSERT_NO_ALLOCATIONS(res = index.upperBound(version));
+    ASSERT_NO_ALLOCATIONS(res = index.maxSatisfying(range));
+    ASSERT_TRUE(res != VersionIndex::npos);
+    // the existing object has the capacity for the tags
+    SemVersion out(0, 0, 0, "alpha.beta.gamma.delta", "");
+    ASSERT_NO_ALLOCATIONS(index.version(res, out));
+    ASSERT_NO_ALLOCATIONS(VersionIndex check(data.data(), data.size()); res = check.size());
+}
+
+TEST(Allocations, stream_parser) {
+    std::size_t count = 0;
+    StreamParser parser([&count](const SemVersion &) { ++count; });
+    const std::string chunk = "1.2.3 1.2.4-rc.1 2.0.0+build.5 nope 3.0.0-alpha.beta.gamma.delta\n";
+    // the first chunk may allocate the buffers for the long tags
+    parser.feed(chunk.data(), chunk.size());
+    ASSERT_NO_ALLOCATIONS(parser.feed(chunk.data(), chunk.size()));
+    ASSERT_NO_ALLOCATIONS(parser.finish());
+    ASSERT_EQ(8, count);
+}
+
+TEST(Allocations, version_stats) {
+    VersionStats stats;
+    const SemVersion version(1, 2, 3, "rc.1", "");
+    stats.add(version);
+    // the counters of the known major and minor exist
+    ASSERT_NO_ALLOCATIONS(stats.add(version));
+}
+
+TEST(Allocations, c_api) {
+    const char * strings[] = {"1.2.3", "1.2.3-alpha.beta.gamma.delta+build.2018.12.31", "nope", "2.0.0"};
+    sts_semver_version versions[4];
+    std::size_t res = 0;
+    ASSERT_NO_ALLOCATIONS(res = sts_semver_parse_n(strings, nullptr, 4, versions));
+    ASSERT_EQ(3, res);
+    std::int8_t results[2];
+    ASSERT_NO_ALLOCATIONS(sts_semver_compare_n(versions, versions + 2, 2, results));
+    std::size_t indices[4];
+    ASSERT_NO_ALLOCATIONS(sts_semver_sort_indices(versions, 4, indices));
+    // the temporary buffer of the stable sort
+    ASSERT_ALLOCATIONS_LE(1, sts_semver_sort(versions, 4));
+
+    sts_semver_range * range = sts_semver_range_parse("^1.0.0", 6);
+    std::uint8_t mask[1];
+    ASSERT_NO_ALLOCATIONS(res = sts_semver_range_match_n(range, versions, 4, mask));
+    ASSERT_EQ(2, res);
+    sts_semver_range_free(range);
+
+    char buffer[128];
+    ASSERT_NO_ALLOCATIONS(res = sts_semver_format_n(versions, 4, 1, 1, '\n', buffer, sizeof(buffer)));
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
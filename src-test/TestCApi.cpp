@@ -0,0 +1,236 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "sts/semver/CApi.h"
+#include "sts/semver/SemVersion.h"
+#include "sts/semver/Range.h"
+
+using namespace sts::semver;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+namespace {
+
+    std::vector<std::string> randomStrings(const std::size_t count) {
+        const char * preReleases[] = {"", "", "", "-alpha", "-alpha.1", "-beta.2", "-beta.11", "-rc.1"};
+        const char * builds[] = {"", "", "", "+build.1", "+sha.5114f85"};
+        std::mt19937 rnd(42);
+        std::vector<std::string> res;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string str = std::to_string(rnd() % 5) + "." + std::to_string(rnd() % 20) + "." +
+                              std::to_string(rnd() % 100) +
+                              preReleases[rnd() % (sizeof(preReleases) / sizeof(preReleases[0]))] +
+                              builds[rnd() % (sizeof(builds) / sizeof(builds[0]))];
+            if (rnd() % 20 == 0) {
+                str = "v" + str;
+            }
+            res.emplace_back(std::move(str));
+        }
+        return res;
+    }
+
+    std::vector<sts_semver_version> parseAll(const std::vector<std::string> & strings) {
+        std::vector<const char *> ptrs;
+        std::vector<std::size_t> lengths;
+        for (auto & s : strings) {
+            ptrs.push_back(s.data());
+            lengths.push_back(s.length());
+        }
+        std::vector<sts_semver_version> res(strings.size());
+        sts_semver_parse_n(ptrs.data(), lengths.data(), ptrs.size(), res.data());
+        return res;
+    }
+
+    std::string tag(const char * ptr, const std::uint32_t length) {
+        return ptr ? std::string(ptr, length) : std::string();
+    }
+
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(CApi, api_version) {
+    ASSERT_EQ(STS_SEMVER_C_API_VERSION, sts_semver_api_version());
+}
+
+TEST(CApi, parse_n) {
+    const auto strings = randomStrings(2000);
+    std::vector<const char *> ptrs;
+    for (auto & s : strings) {
+        ptrs.push_back(s.c_str());
+    }
+    std::vector<sts_semver_version> versions(strings.size());
+    // null-terminated strings
+    const std::size_t valid = sts_semver_parse_n(ptrs.data(), nullptr, ptrs.size(), versions.data());
+
+    std::size_t expectedValid = 0;
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        const bool isValid = SemVersion::isValid(strings[i]);
+        const SemVersion expected = SemVersion::parse(strings[i]);
+        const sts_semver_version & v = versions[i];
+        ASSERT_EQ(isValid ? 1u : 0u, v.valid) << strings[i];
+        if (!isValid) {
+            continue;
+        }
+        ++expectedValid;
+        ASSERT_EQ(expected.mMajor, v.major);
+        ASSERT_EQ(expected.mMinor, v.minor);
+        ASSERT_EQ(expected.mPatch, v.patch);
+        ASSERT_EQ(expected.mPreRelease, tag(v.pre_release, v.pre_release_length));
+        ASSERT_EQ(expected.mBuild, tag(v.build, v.build_length));
+    }
+    ASSERT_EQ(expectedValid, valid);
+
+    const char * nullString = nullptr;
+    sts_semver_version invalid;
+    ASSERT_EQ(0, sts_semver_parse_n(&nullString, nullptr, 1, &invalid));
+    ASSERT_EQ(0u, invalid.valid);
+    ASSERT_EQ(0u, invalid.major);
+}
+
+TEST(CApi, parse_buffer) {
+    const char data[] = "  1.2.3\n1.2.3-rc.1+b.2\tv1.0.0 \r\n 10.20.30";
+    sts_semver_version versions[4];
+    ASSERT_EQ(4, sts_semver_parse_buffer(data, sizeof(data) - 1, versions, 4));
+    ASSERT_EQ(1u, versions[0].valid);
+    ASSERT_EQ(3u, versions[0].patch);
+    ASSERT_EQ(1u, versions[1].valid);
+    ASSERT_EQ("rc.1", tag(versions[1].pre_release, versions[1].pre_release_length));
+    ASSERT_EQ("b.2", tag(versions[1].build, versions[1].build_length));
+    ASSERT_EQ(0u, versions[2].valid);
+    ASSERT_EQ(1u, versions[3].valid);
+    ASSERT_EQ(30u, versions[3].patch);
+
+    // only the number of the tokens
+    ASSERT_EQ(4, sts_semver_parse_buffer(data, sizeof(data) - 1, nullptr, 0));
+    ASSERT_EQ(0, sts_semver_parse_buffer(" \n ", 3, nullptr, 0));
+}
+
+TEST(CApi, compare_n) {
+    const auto strings = randomStrings(2000);
+    const auto versions = parseAll(strings);
+    const std::size_t half = versions.size() / 2;
+    std::vector<std::int8_t> results(half);
+    sts_semver_compare_n(versions.data(), versions.data() + half, half, results.data());
+    for (std::size_t i = 0; i < half; ++i) {
+        const bool lValid = SemVersion::isValid(strings[i]);
+        const bool rValid = SemVersion::isValid(strings[half + i]);
+        int expected = 0;
+        if (!lValid || !rValid) {
+            expected = lValid == rValid ? 0 : (lValid ? 1 : -1);
+        }
+        else {
+            expected = SemVersion::parse(strings[i]).comparePrecedence(SemVersion::parse(strings[half + i]));
+        }
+        ASSERT_EQ(expected, results[i]) << strings[i] << " " << strings[half + i];
+        ASSERT_EQ(expected, sts_semver_compare(&versions[i], &versions[half + i]));
+    }
+}
+
+TEST(CApi, sort) {
+    const auto strings = randomStrings(2000);
+    auto versions = parseAll(strings);
+    std::vector<std::size_t> indices(versions.size());
+    sts_semver_sort_indices(versions.data(), versions.size(), indices.data());
+    sts_semver_sort(versions.data(), versions.size());
+    for (std::size_t i = 0; i < versions.size(); ++i) {
+        if (i != 0) {
+            ASSERT_LE(sts_semver_compare(&versions[i - 1], &versions[i]), 0);
+        }
+    }
+    // both sorts are stable so they give the same order
+    const auto original = parseAll(strings);
+    for (std::size_t i = 0; i < versions.size(); ++i) {
+        ASSERT_EQ(0, std::memcmp(&versions[i], &original[indices[i]], sizeof(sts_semver_version)));
+    }
+    // invalid versions are first
+    ASSERT_EQ(0u, versions.front().valid);
+    ASSERT_EQ(1u, versions.back().valid);
+}
+
+TEST(CApi, range_match_n) {
+    const auto strings = randomStrings(2000);
+    const auto versions = parseAll(strings);
+    const char * ranges[] = {"*", "^1.2.3", "~2.5.0", ">=1.0.0-alpha <2.0.0", "=3.3.3 || ^0.1.0", "<0.0.0"};
+    for (auto r : ranges) {
+        sts_semver_range * range = sts_semver_range_parse(r, std::strlen(r));
+        ASSERT_TRUE(range != nullptr) << r;
+        std::vector<std::uint8_t> mask((versions.size() + 7) / 8, 0xFF);
+        const std::size_t matched = sts_semver_range_match_n(range, versions.data(), versions.size(), mask.data());
+        sts_semver_range_free(range);
+
+        const Range expected = Range::parse(r);
+        std::size_t expectedMatched = 0;
+        for (std::size_t i = 0; i < versions.size(); ++i) {
+            const bool contains = SemVersion::isValid(strings[i]) && expected.contains(SemVersion::parse(strings[i]));
+            expectedMatched += contains;
+            ASSERT_EQ(contains, ((mask[i / 8] >> (i % 8)) & 1) != 0) << r << " " << strings[i];
+        }
+        ASSERT_EQ(expectedMatched, matched) << r;
+    }
+    ASSERT_TRUE(sts_semver_range_parse("nope", 4) == nullptr);
+    sts_semver_range_free(nullptr);
+    std::vector<std::uint8_t> mask((versions.size() + 7) / 8, 0xFF);
+    ASSERT_EQ(0, sts_semver_range_match_n(nullptr, versions.data(), versions.size(), mask.data()));
+    ASSERT_EQ(std::vector<std::uint8_t>(mask.size(), 0), mask);
+}
+
+TEST(CApi, format_n) {
+    const char * strings[] = {"1.2.3", "nope", "1.0.0-rc.1+build.5", "4294967295.0.10"};
+    sts_semver_version versions[4];
+    sts_semver_parse_n(strings, nullptr, 4, versions);
+
+    const std::size_t size = sts_semver_format_n(versions, 4, 1, 1, '\n', nullptr, 0);
+    const std::string expected = "1.2.3\n\n1.0.0-rc.1+build.5\n4294967295.0.10";
+    ASSERT_EQ(expected.size() + 1, size);
+    std::vector<char> buffer(size - 1);
+    ASSERT_EQ(size, sts_semver_format_n(versions, 4, 1, 1, '\n', buffer.data(), buffer.size()));
+    buffer.resize(size);
+    ASSERT_EQ(size, sts_semver_format_n(versions, 4, 1, 1, '\n', buffer.data(), buffer.size()));
+    ASSERT_STREQ(expected.c_str(), buffer.data());
+
+    char shortBuffer[64];
+    ASSERT_EQ(34, sts_semver_format_n(versions, 4, 1, 0, ',', shortBuffer, sizeof(shortBuffer)));
+    ASSERT_STREQ("1.2.3,,1.0.0-rc.1,4294967295.0.10", shortBuffer);
+    ASSERT_EQ(1, sts_semver_format_n(versions, 0, 1, 1, ',', shortBuffer, sizeof(shortBuffer)));
+    ASSERT_STREQ("", shortBuffer);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,145 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <algorithm>
+#include <random>
+#include "gtest/gtest.h"
+#include "sts/semver/CompactVersionSet.h"
+#include "RandomVersions.h"
+
+using namespace sts::semver;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(CompactVersionSet, empty) {
+    const CompactVersionSet set;
+    ASSERT_TRUE(set.empty());
+    ASSERT_EQ(0, set.size());
+    ASSERT_TRUE(set.begin() == set.end());
+    ASSERT_FALSE(set.contains(SemVersion(1, 2, 3)));
+    ASSERT_TRUE(set.lowerBound(SemVersion(1, 2, 3)) == set.end());
+}
+
+TEST(CompactVersionSet, iteration) {
+    std::mt19937 rnd(1);
+    std::vector<SemVersion> versions;
+    for (int i = 0; i < 5000; ++i) {
+        versions.emplace_back(randomVersion(rnd));
+    }
+    const std::vector<SemVersion> expected = sortedUnique(versions);
+    for (std::size_t blockSize : {1, 7, 64}) {
+        const CompactVersionSet set(versions, blockSize);
+        ASSERT_EQ(expected.size(), set.size());
+        std::size_t i = 0;
+        for (auto & v : set) {
+            ASSERT_TRUE(equalVersion(expected[i], v)) << expected[i].toString(true, true) << " " << v.toString(true, true);
+            ++i;
+        }
+        ASSERT_EQ(expected.size(), i);
+        for (std::size_t index : {std::size_t(0), expected.size() / 2, expected.size() - 1}) {
+            ASSERT_TRUE(equalVersion(expected[index], *set.at(index)));
+            ASSERT_EQ(index, set.at(index).index());
+        }
+    }
+}
+
+TEST(CompactVersionSet, contains) {
+    std::mt19937 rnd(2);
+    std::vector<SemVersion> versions;
+    for (int i = 0; i < 2000; ++i) {
+        versions.emplace_back(randomVersion(rnd));
+    }
+    const CompactVersionSet set(versions, 16);
+    for (auto & v : versions) {
+        ASSERT_TRUE(set.contains(v)) << v.toString(true, true);
+    }
+    const std::vector<SemVersion> expected = sortedUnique(versions);
+    for (int i = 0; i < 2000; ++i) {
+        const SemVersion v = randomVersion(rnd);
+        ASSERT_EQ(std::binary_search(expected.begin(), expected.end(), v, lessVersion), set.contains(v))
+                            << v.toString(true, true);
+    }
+    ASSERT_FALSE(set.contains(SemVersion(1, 2, 3, "unknown", "")));
+    ASSERT_FALSE(set.contains(SemVersion(1, 2, 3, "", "unknown")));
+    ASSERT_FALSE(set.contains(SemVersion(100, 0, 0)));
+}
+
+TEST(CompactVersionSet, lowerBound) {
+    std::mt19937 rnd(3);
+    std::vector<SemVersion> versions;
+    for (int i = 0; i < 2000; ++i) {
+        versions.emplace_back(randomVersion(rnd));
+    }
+    const std::vector<SemVersion> expected = sortedUnique(versions);
+    const CompactVersionSet set(versions, 16);
+    std::vector<SemVersion> queries;
+    for (int i = 0; i < 2000; ++i) {
+        queries.emplace_back(randomVersion(rnd));
+    }
+    queries.emplace_back(0, 0, 0);
+    queries.emplace_back(100, 0, 0);
+    queries.emplace_back(1, 2, 3, "beta.3", "");
+    queries.emplace_back(1, 2, 3, "zzz", "");
+    for (auto & q : queries) {
+        const auto found = std::lower_bound(expected.begin(), expected.end(), q,
+                                            [](const SemVersion & l, const SemVersion & r) {
+                                                return l.comparePrecedence(r) < 0;
+                                            });
+        const auto res = set.lowerBound(q);
+        ASSERT_EQ(static_cast<std::size_t>(found - expected.begin()), res.index()) << q.toString(true, true);
+        if (found != expected.end()) {
+            ASSERT_TRUE(equalVersion(*found, *res));
+        }
+    }
+}
+
+TEST(CompactVersionSet, compression) {
+    std::mt19937 rnd(4);
+    std::vector<SemVersion> versions;
+    for (std::uint32_t major = 0; major < 10; ++major) {
+        for (std::uint32_t minor = 0; minor < 50; ++minor) {
+            for (std::uint32_t patch = 0; patch < 200; ++patch) {
+                versions.emplace_back(major, minor, patch);
+                if (rnd() % 4 == 0) {
+                    versions.emplace_back(major, minor, patch, "rc.1", "");
+                }
+            }
+        }
+    }
+    const CompactVersionSet set(versions);
+    const std::size_t plain = versions.size() * sizeof(SemVersion);
+    // the target is at least 10 times smaller than the std::vector<SemVersion>
+    ASSERT_GT(plain / set.memoryUsage(), 10u) << plain << " " << set.memoryUsage();
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,172 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <random>
+#include "gtest/gtest.h"
+#include "sts/semver/PreReleaseIndex.h"
+
+using namespace sts::semver;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+namespace {
+
+    std::vector<SemVersion> makeVersions(const unsigned seed, const std::size_t count) {
+        static const char * tags[] = {"alpha", "alpha2", "beta", "rc", "nightly", "x"};
+        std::mt19937 rnd(seed);
+        std::vector<SemVersion> res;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string preRelease;
+            const std::size_t identifiers = rnd() % 4;
+            for (std::size_t n = 0; n < identifiers; ++n) {
+                if (n != 0) {
+                    preRelease += ".";
+                }
+                preRelease += rnd() % 3 == 0 ? std::to_string(rnd() % 5) : tags[rnd() % 6];
+            }
+            res.emplace_back(rnd() % 3, rnd() % 4, rnd() % 5, preRelease, "");
+        }
+        return res;
+    }
+
+    // Reference implementation of the query.
+    std::vector<std::size_t> naiveFind(const std::vector<SemVersion> & versions, const PreReleaseIndex::Query & query) {
+        std::vector<std::size_t> res;
+        for (std::size_t i = 0; i < versions.size(); ++i) {
+            const SemVersion & v = versions[i];
+            if (v.mPreRelease.empty() || !query.mMajor.contains(v.mMajor) ||
+                !query.mMinor.contains(v.mMinor) || !query.mPatch.contains(v.mPatch)) {
+                continue;
+            }
+            std::vector<std::string> identifiers(1);
+            for (char c : v.mPreRelease) {
+                if (c == '.') {
+                    identifiers.emplace_back();
+                }
+                else {
+                    identifiers.back() += c;
+                }
+            }
+            if (query.mPosition >= identifiers.size()) {
+                continue;
+            }
+            const std::string & id = identifiers[query.mPosition];
+            if (query.mPrefix ? id.compare(0, query.mIdentifier.length(), query.mIdentifier) == 0
+                              : id == query.mIdentifier) {
+                res.push_back(i);
+            }
+        }
+        return res;
+    }
+
+    PreReleaseIndex::Query query(const std::string & identifier, const bool prefix = false, const std::size_t position = 0) {
+        PreReleaseIndex::Query res;
+        res.mIdentifier = identifier;
+        res.mPrefix = prefix;
+        res.mPosition = position;
+        return res;
+    }
+
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(PreReleaseIndex, exact_and_prefix) {
+    PreReleaseIndex index({
+        SemVersion(1, 0, 0, "alpha", ""),
+        SemVersion(1, 0, 0, "alpha.1", ""),
+        SemVersion(1, 0, 0, "alpha2", ""),
+        SemVersion(1, 0, 0, "beta.alpha", ""),
+        SemVersion(1, 0, 0),
+    });
+    ASSERT_EQ(5, index.size());
+    ASSERT_EQ(4, index.identifierCount());
+    ASSERT_EQ(std::vector<std::size_t>({0, 1}), index.find(query("alpha")));
+    ASSERT_EQ(std::vector<std::size_t>({0, 1, 2}), index.find(query("alpha", true)));
+    ASSERT_EQ(std::vector<std::size_t>({3}), index.find(query("alpha", true, 1)));
+    ASSERT_EQ(std::vector<std::size_t>({0, 1, 2, 3}), index.find(query("", true)));
+    ASSERT_TRUE(index.find(query("gamma")).empty());
+    ASSERT_TRUE(index.find(query("alpha", false, 5)).empty());
+}
+
+TEST(PreReleaseIndex, bounds) {
+    PreReleaseIndex index;
+    index.insert(SemVersion(1, 2, 0, "rc.1", ""));
+    index.insert(SemVersion(1, 3, 0, "rc.1", ""));
+    index.insert(SemVersion(2, 0, 0, "rc.1", ""));
+    auto q = query("rc");
+    q.mMajor.mMin = q.mMajor.mMax = 1;
+    q.mMinor.mMin = 3;
+    ASSERT_EQ(std::vector<std::size_t>({1}), index.find(q));
+}
+
+TEST(PreReleaseIndex, latest_per_minor) {
+    PreReleaseIndex index;
+    index.insert(SemVersion(1, 2, 0, "rc.2", ""));
+    index.insert(SemVersion(1, 2, 1, "rc.1", ""));
+    index.insert(SemVersion(1, 2, 0, "rc.10", ""));
+    index.insert(SemVersion(1, 1, 5, "rc", ""));
+    index.insert(SemVersion(1, 3, 0, "beta", ""));
+    const auto res = index.latestPerMinor(query("rc"));
+    ASSERT_EQ(std::vector<std::size_t>({3, 1}), res);
+}
+
+TEST(PreReleaseIndex, bulk_equals_incremental) {
+    for (unsigned seed = 1; seed <= 5; ++seed) {
+        const auto versions = makeVersions(seed, 2000);
+        PreReleaseIndex bulk(versions);
+        PreReleaseIndex incremental;
+        for (auto & v : versions) {
+            incremental.insert(v);
+        }
+        ASSERT_EQ(bulk.identifierCount(), incremental.identifierCount());
+
+        std::mt19937 rnd(seed);
+        for (const char * identifier : {"", "a", "alpha", "alpha2", "beta", "n", "1", "x", "zzz"}) {
+            for (std::size_t position = 0; position < 4; ++position) {
+                for (bool prefix : {false, true}) {
+                    auto q = query(identifier, prefix, position);
+                    q.mMajor.mMin = rnd() % 2;
+                    q.mPatch.mMax = 1 + rnd() % 4;
+                    const auto expected = naiveFind(versions, q);
+                    ASSERT_EQ(expected, bulk.find(q)) << identifier << " " << position << " " << prefix;
+                    ASSERT_EQ(expected, incremental.find(q)) << identifier << " " << position << " " << prefix;
+                }
+            }
+        }
+    }
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,134 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include "gtest/gtest.h"
+#include "sts/semver/Range.h"
+
+using namespace sts::semver;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(Range, parse_invalid) {
+    ASSERT_FALSE(Range::parse(nullptr));
+    ASSERT_FALSE(Range::parse("1.2"));
+    ASSERT_FALSE(Range::parse(">=1.2.3 <"));
+    ASSERT_FALSE(Range::parse("=>1.2.3"));
+    ASSERT_FALSE(Range::parse("<<1.2.3"));
+    ASSERT_FALSE(Range::parse("1.2.3 || x"));
+}
+
+TEST(Range, parse) {
+    const Range range = Range::parse(">=1.2.3 < 2.0.0 || =3.0.0-rc.1");
+    ASSERT_TRUE(range);
+    ASSERT_EQ(2, range.mSets.size());
+    ASSERT_EQ(2, range.mSets[0].size());
+    ASSERT_EQ(Range::Operation::GreaterOrEqual, range.mSets[0][0].mOperation);
+    ASSERT_STREQ("1.2.3", range.mSets[0][0].mVersion.toString(true, true).c_str());
+    ASSERT_EQ(Range::Operation::Less, range.mSets[0][1].mOperation);
+    ASSERT_STREQ("2.0.0", range.mSets[0][1].mVersion.toString(true, true).c_str());
+    ASSERT_EQ(1, range.mSets[1].size());
+    ASSERT_EQ(Range::Operation::Equal, range.mSets[1][0].mOperation);
+    ASSERT_STREQ("3.0.0-rc.1", range.mSets[1][0].mVersion.toString(true, true).c_str());
+}
+
+TEST(Range, any) {
+    for (auto str : {"", "*", " * ", "1.0.0 || *"}) {
+        const Range range = Range::parse(str);
+        ASSERT_TRUE(range) << str;
+        ASSERT_TRUE(range.contains(SemVersion(0, 0, 0))) << str;
+        ASSERT_TRUE(range.contains(SemVersion(5, 6, 7, "rc", ""))) << str;
+    }
+}
+
+TEST(Range, contains) {
+    const Range range = Range::parse(">1.2.3 <=2.0.0 || 0.1.0");
+    ASSERT_TRUE(range.contains(SemVersion::parse("1.2.4")));
+    ASSERT_TRUE(range.contains(SemVersion::parse("2.0.0")));
+    ASSERT_TRUE(range.contains(SemVersion::parse("2.0.0-rc.1")));
+    ASSERT_TRUE(range.contains(SemVersion::parse("0.1.0+build")));
+    ASSERT_FALSE(range.contains(SemVersion::parse("1.2.3")));
+    ASSERT_FALSE(range.contains(SemVersion::parse("2.0.1")));
+    ASSERT_FALSE(range.contains(SemVersion::parse("0.1.0-rc")));
+    ASSERT_FALSE(Range().contains(SemVersion(1, 2, 3)));
+}
+
+TEST(Range, caret) {
+    const Range r1 = Range::parse("^1.2.3");
+    ASSERT_TRUE(r1.contains(SemVersion::parse("1.2.3")));
+    ASSERT_TRUE(r1.contains(SemVersion::parse("1.9.0")));
+    ASSERT_FALSE(r1.contains(SemVersion::parse("1.2.3-rc")));
+    ASSERT_FALSE(r1.contains(SemVersion::parse("2.0.0-rc")));
+    ASSERT_FALSE(r1.contains(SemVersion::parse("2.0.0")));
+
+    const Range r2 = Range::parse("^0.2.3");
+    ASSERT_TRUE(r2.contains(SemVersion::parse("0.2.9")));
+    ASSERT_FALSE(r2.contains(SemVersion::parse("0.3.0")));
+
+    const Range r3 = Range::parse("^0.0.3");
+    ASSERT_TRUE(r3.contains(SemVersion::parse("0.0.3")));
+    ASSERT_FALSE(r3.contains(SemVersion::parse("0.0.4")));
+}
+
+TEST(Range, tilde) {
+    const Range range = Range::parse("~1.2.3");
+    ASSERT_TRUE(range.contains(SemVersion::parse("1.2.3")));
+    ASSERT_TRUE(range.contains(SemVersion::parse("1.2.99")));
+    ASSERT_FALSE(range.contains(SemVersion::parse("1.3.0-alpha")));
+    ASSERT_FALSE(range.contains(SemVersion::parse("1.3.0")));
+}
+
+TEST(Range, caret_tilde_max_numbers) {
+    // the max major has no upper bound
+    const Range r1 = Range::parse("^4294967295.0.0");
+    ASSERT_TRUE(r1);
+    ASSERT_EQ(1, r1.mSets[0].size());
+    ASSERT_TRUE(r1.contains(SemVersion::parse("4294967295.0.0")));
+    ASSERT_TRUE(r1.contains(SemVersion::parse("4294967295.4294967295.1")));
+    ASSERT_FALSE(r1.contains(SemVersion::parse("4294967294.9.9")));
+
+    // the max minor is carried to the major
+    const Range r2 = Range::parse("~1.4294967295.0");
+    ASSERT_TRUE(r2.contains(SemVersion::parse("1.4294967295.7")));
+    ASSERT_FALSE(r2.contains(SemVersion::parse("2.0.0-rc")));
+    ASSERT_FALSE(r2.contains(SemVersion::parse("2.0.0")));
+
+    const Range r3 = Range::parse("^0.0.4294967295");
+    ASSERT_TRUE(r3.contains(SemVersion::parse("0.0.4294967295")));
+    ASSERT_FALSE(r3.contains(SemVersion::parse("0.1.0")));
+
+    const Range r4 = Range::parse("~4294967295.4294967295.1");
+    ASSERT_EQ(1, r4.mSets[0].size());
+    ASSERT_TRUE(r4.contains(SemVersion::parse("4294967295.4294967295.4294967295")));
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,320 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cctype>
+#include <random>
+#include <set>
+#include "gtest/gtest.h"
+#include "sts/semver/Resolver.h"
+#include "sts/semver/Range.h"
+
+using namespace sts::semver;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+namespace {
+
+    Dependency dep(const std::string & package, const std::string & range) {
+        Dependency res;
+        res.mPackage = package;
+        res.mRange = range;
+        return res;
+    }
+
+    // Checks that the result satisfies all the requirements.
+    void assertConsistent(MemoryProvider & provider, const std::vector<Dependency> & requirements,
+                          const Resolver::Result & result) {
+        ASSERT_TRUE(result.mResolved);
+        std::vector<Dependency> all = requirements;
+        for (auto & v : result.mVersions) {
+            const auto deps = provider.dependencies(v.first, v.second);
+            all.insert(all.end(), deps.begin(), deps.end());
+        }
+        for (auto & d : all) {
+            const auto found = result.mVersions.find(d.mPackage);
+            ASSERT_TRUE(found != result.mVersions.end()) << d.mPackage;
+            ASSERT_TRUE(Range::parse(d.mRange).contains(found->second)) << d.mPackage << " " << d.mRange;
+        }
+    }
+
+    /*
+     * Synthetic corpus: layers of packages, each version depends on several packages of the next layer.
+     * Every package has one major version which is compatible with the others (a planted solution).
+     * The newer majors often want the newer dependencies which may not exist or conflict with the other ones.
+     * The older majors want random ones, so the resolver has to go back and forth.
+     * The first dependency is always the package with the same index from the next layer,
+     * so all the packages are reachable.
+     * If the conflict name is set, all the versions of that package from the last layer require "z ^1.0.0"
+     * and the root requires "z ^2.0.0", so there is no solution.
+     */
+    void makeLayeredGraph(MemoryProvider & provider, std::vector<Dependency> & outRequirements,
+                          const std::size_t layers, const std::size_t width, const unsigned seed,
+                          const std::string & conflict = std::string()) {
+        std::mt19937 rnd(seed);
+        std::vector<std::uint32_t> planted(layers * width);
+        for (auto & p : planted) {
+            p = 1 + rnd() % 3;
+        }
+        for (std::size_t l = 0; l < layers; ++l) {
+            for (std::size_t w = 0; w < width; ++w) {
+                const std::string name = "p" + std::to_string(l) + "_" + std::to_string(w);
+                for (std::uint32_t major = 1; major <= 3; ++major) {
+                    // minor versions usually have the same dependencies
+                    std::vector<Dependency> deps;
+                    if (l + 1 != layers) {
+                        for (int d = 0; d < 3; ++d) {
+                            const std::size_t index = d == 0 ? w : rnd() % width;
+                            const std::string target = "p" + std::to_string(l + 1) + "_" + std::to_string(index);
+                            std::uint32_t wanted = planted[(l + 1) * width + index];
+                            if (major > planted[l * width + w] && rnd() % 2 == 0) {
+                                wanted += 1;
+                            }
+                            else if (major < planted[l * width + w] && rnd() % 2 == 0) {
+                                wanted = 1 + rnd() % 3;
+                            }
+                            deps.emplace_back(dep(target, "^" + std::to_string(wanted) + ".0.0"));
+                        }
+                    }
+                    if (name == conflict) {
+                        deps.emplace_back(dep("z", "^1.0.0"));
+                    }
+                    for (std::uint32_t minor = 0; minor < 4; ++minor) {
+                        provider.add(name, SemVersion(major, minor, 0), deps);
+                    }
+                }
+            }
+        }
+        for (std::size_t w = 0; w < width; ++w) {
+            outRequirements.emplace_back(dep("p0_" + std::to_string(w), ">=1.0.0"));
+        }
+        if (!conflict.empty()) {
+            provider.add("z", SemVersion(1, 0, 0), {});
+            provider.add("z", SemVersion(2, 0, 0), {});
+            outRequirements.emplace_back(dep("z", "^2.0.0"));
+        }
+    }
+
+    // The packages which depend on the package directly or transitively, and the package itself.
+    std::set<std::string> dependents(MemoryProvider & provider, const std::size_t layers, const std::size_t width,
+                                     const std::string & package) {
+        std::set<std::string> res = {package};
+        for (std::size_t l = layers - 1; l-- > 0;) {
+            for (std::size_t w = 0; w < width; ++w) {
+                const std::string name = "p" + std::to_string(l) + "_" + std::to_string(w);
+                for (auto & v : provider.versions(name)) {
+                    for (auto & d : provider.dependencies(name, v)) {
+                        if (res.count(d.mPackage) != 0) {
+                            res.insert(name);
+                        }
+                    }
+                }
+            }
+        }
+        return res;
+    }
+
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(Resolver, newest_first) {
+    MemoryProvider provider;
+    provider.add("a", SemVersion(1, 0, 0), {dep("b", "^1.0.0")});
+    provider.add("a", SemVersion(1, 1, 0), {dep("b", "^1.1.0")});
+    provider.add("b", SemVersion(1, 0, 0), {});
+    provider.add("b", SemVersion(1, 2, 0), {});
+    provider.add("b", SemVersion(2, 0, 0), {});
+
+    Resolver resolver(provider);
+    const std::vector<Dependency> requirements = {dep("a", "*")};
+    const auto res = resolver.resolve(requirements);
+    assertConsistent(provider, requirements, res);
+    ASSERT_EQ(2, res.mVersions.size());
+    ASSERT_STREQ("1.1.0", res.mVersions.at("a").toString().c_str());
+    ASSERT_STREQ("1.2.0", res.mVersions.at("b").toString().c_str());
+}
+
+TEST(Resolver, backtracking) {
+    MemoryProvider provider;
+    provider.add("a", SemVersion(1, 0, 0), {dep("c", "^1.0.0")});
+    provider.add("a", SemVersion(2, 0, 0), {dep("c", "^2.0.0")});
+    provider.add("b", SemVersion(1, 0, 0), {dep("c", "<2.0.0")});
+    provider.add("c", SemVersion(1, 5, 0), {});
+    provider.add("c", SemVersion(2, 0, 0), {});
+
+    Resolver resolver(provider);
+    const std::vector<Dependency> requirements = {dep("a", "*"), dep("b", "*")};
+    const auto res = resolver.resolve(requirements);
+    assertConsistent(provider, requirements, res);
+    ASSERT_STREQ("1.0.0", res.mVersions.at("a").toString().c_str());
+    ASSERT_STREQ("1.5.0", res.mVersions.at("c").toString().c_str());
+}
+
+TEST(Resolver, conflict) {
+    MemoryProvider provider;
+    provider.add("a", SemVersion(1, 0, 0), {dep("c", "^1.0.0")});
+    provider.add("b", SemVersion(1, 0, 0), {dep("c", "^2.0.0")});
+    provider.add("c", SemVersion(1, 0, 0), {});
+    provider.add("c", SemVersion(2, 0, 0), {});
+
+    Resolver resolver(provider);
+    const auto res = resolver.resolve({dep("a", "*"), dep("b", "*")});
+    ASSERT_FALSE(res.mResolved);
+    ASSERT_FALSE(res.mConflict.empty());
+    std::string text;
+    for (auto & line : res.mConflict) {
+        text += line + "\n";
+    }
+    ASSERT_NE(std::string::npos, text.find("b 1.0.0 requires c ^2.0.0")) << text;
+    ASSERT_NE(std::string::npos, text.find("a 1.0.0 -> ^1.0.0")) << text;
+}
+
+TEST(Resolver, minimal_conflict) {
+    // only a -> c and b -> c conflict, the other packages and dependencies mustn't be in the explanation
+    MemoryProvider provider;
+    std::vector<Dependency> requirements;
+    for (int i = 0; i < 10; ++i) {
+        const std::string name = "x" + std::to_string(i);
+        provider.add(name, SemVersion(1, 0, 0), {dep("c", ">=1.0.0")});
+        provider.add(name, SemVersion(2, 0, 0), {dep("c", "*")});
+        requirements.emplace_back(dep(name, "*"));
+    }
+    for (std::uint32_t i = 0; i < 3; ++i) {
+        provider.add("a", SemVersion(1, i, 0), {dep("c", "^1.0.0"), dep("d", "*")});
+    }
+    provider.add("b", SemVersion(1, 0, 0), {dep("c", "^2.0.0"), dep("d", "^1.0.0")});
+    provider.add("c", SemVersion(1, 0, 0), {});
+    provider.add("c", SemVersion(2, 0, 0), {});
+    provider.add("d", SemVersion(1, 0, 0), {});
+    requirements.emplace_back(dep("a", "*"));
+    requirements.emplace_back(dep("b", "*"));
+    requirements.emplace_back(dep("d", "*"));
+
+    Resolver resolver(provider);
+    const auto res = resolver.resolve(requirements);
+    ASSERT_FALSE(res.mResolved);
+    std::string text;
+    for (auto & line : res.mConflict) {
+        text += line + "\n";
+    }
+    ASSERT_NE(std::string::npos, text.find("requires c ^2.0.0")) << text;
+    ASSERT_NE(std::string::npos, text.find("^1.0.0")) << text;
+    ASSERT_EQ(std::string::npos, text.find("x")) << text;
+    ASSERT_EQ(std::string::npos, text.find(" d ")) << text;
+    ASSERT_EQ(std::string::npos, text.find(">=1.0.0")) << text;
+}
+
+TEST(Resolver, unknown_package) {
+    MemoryProvider provider;
+    provider.add("a", SemVersion(1, 0, 0), {});
+    Resolver resolver(provider);
+    const auto res = resolver.resolve({dep("a", "*"), dep("x", "^1.0.0")});
+    ASSERT_FALSE(res.mResolved);
+    ASSERT_EQ(3, res.mConflict.size());
+    ASSERT_STREQ("    root requires x ^1.0.0", res.mConflict[1].c_str());
+    ASSERT_STREQ("    there are no versions of x", res.mConflict[2].c_str());
+}
+
+TEST(Resolver, backjumping) {
+    // 2^20 combinations of the independent packages must not be tried.
+    MemoryProvider provider;
+    std::vector<Dependency> requirements;
+    for (int i = 0; i < 20; ++i) {
+        const std::string name = "x" + std::to_string(i);
+        provider.add(name, SemVersion(1, 0, 0), {});
+        provider.add(name, SemVersion(2, 0, 0), {});
+        requirements.emplace_back(dep(name, "*"));
+    }
+    for (std::uint32_t i = 0; i < 5; ++i) {
+        provider.add("a", SemVersion(1, i, 0), {dep("c", "=1.0.0")});
+        provider.add("b", SemVersion(1, i, 0), {dep("c", "=2.0.0")});
+    }
+    provider.add("c", SemVersion(1, 0, 0), {});
+    provider.add("c", SemVersion(2, 0, 0), {});
+    requirements.emplace_back(dep("a", "*"));
+    requirements.emplace_back(dep("b", "*"));
+
+    Resolver resolver(provider);
+    const auto res = resolver.resolve(requirements);
+    ASSERT_FALSE(res.mResolved);
+    ASSERT_LT(res.mAttempts, 200u);
+}
+
+TEST(Resolver, synthetic_corpus) {
+    for (unsigned seed = 1; seed <= 5; ++seed) {
+        MemoryProvider provider;
+        std::vector<Dependency> requirements;
+        makeLayeredGraph(provider, requirements, 10, 100, seed);
+        Resolver resolver(provider);
+        const auto res = resolver.resolve(requirements);
+        assertConsistent(provider, requirements, res);
+        ASSERT_EQ(1000, res.mVersions.size());
+    }
+}
+
+TEST(Resolver, synthetic_corpus_conflict) {
+    const std::size_t layers = 10;
+    const std::size_t width = 100;
+    for (unsigned seed = 1; seed <= 3; ++seed) {
+        const std::string conflict = "p" + std::to_string(layers - 1) + "_" + std::to_string(seed * 7 % width);
+        MemoryProvider provider;
+        std::vector<Dependency> requirements;
+        makeLayeredGraph(provider, requirements, layers, width, seed, conflict);
+        Resolver resolver(provider);
+        const auto res = resolver.resolve(requirements);
+        ASSERT_FALSE(res.mResolved);
+        ASSERT_LT(res.mAttempts, 5000u);
+
+        std::string text;
+        for (auto & line : res.mConflict) {
+            text += line + "\n";
+        }
+        ASSERT_NE(std::string::npos, text.find("root requires z ^2.0.0")) << text;
+        ASSERT_NE(std::string::npos, text.find(conflict + " ")) << text;
+        ASSERT_NE(std::string::npos, text.find("requires z ^1.0.0")) << text;
+        // only the packages which lead to the conflicting one can be in the explanation
+        const std::set<std::string> allowed = dependents(provider, layers, width, conflict);
+        for (std::size_t pos = text.find('p'); pos != std::string::npos; pos = text.find('p', pos + 1)) {
+            if (pos != 0 && std::isalpha(static_cast<unsigned char>(text[pos - 1]))) {
+                continue;
+            }
+            const std::size_t end = text.find(' ', pos);
+            const std::string name = text.substr(pos, end - pos);
+            ASSERT_NE(0u, allowed.count(name)) << name << "\n" << text;
+        }
+    }
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
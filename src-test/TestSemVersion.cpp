@@ -27,6 +27,7 @@
 **  Contacts: www.steptosky.com
 */
 
+#include <regex>
 #include "gtest/gtest.h"
 #include "sts/semver/SemVersion.h"
 
@@ -72,6 +73,19 @@ TEST(SemVersion, constructor_init_3) {
     ASSERT_STREQ("build", v.mBuild.c_str());
 }
 
+TEST(SemVersion, constructor_init_4) {
+    std::string pre(64, 'p');
+    std::string build(64, 'b');
+    const char * preData = pre.data();
+    const char * buildData = build.data();
+    SemVersion v(1, 2, 3, std::move(pre), std::move(build));
+    ASSERT_EQ(1, v.mMajor);
+    ASSERT_EQ(2, v.mMinor);
+    ASSERT_EQ(3, v.mPatch);
+    ASSERT_EQ(preData, v.mPreRelease.data());
+    ASSERT_EQ(buildData, v.mBuild.data());
+}
+
 /**************************************************************************************************/
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /**************************************************************************************************/
@@ -174,6 +188,100 @@ TEST(SemVersion, set_4_null) {
     ASSERT_EQ(0, v.mBuild.length());
 }
 
+TEST(SemVersion, set_5_move) {
+    SemVersion v(1, 2, 3, "test1", "test2");
+    std::string pre(64, 'p');
+    const char * preData = pre.data();
+    v.set(5, 6, 7, std::move(pre), std::string("test4"));
+    ASSERT_EQ(5, v.mMajor);
+    ASSERT_EQ(6, v.mMinor);
+    ASSERT_EQ(7, v.mPatch);
+    ASSERT_EQ(preData, v.mPreRelease.data());
+    ASSERT_STREQ("test4", v.mBuild.c_str());
+}
+
+TEST(SemVersion, set_6_length) {
+    SemVersion v(1, 2, 3, std::string(64, 'p'), std::string(64, 'b'));
+    const char * preData = v.mPreRelease.data();
+    const char * buildData = v.mBuild.data();
+    v.set(5, 6, 7, "test3-tail", 5, nullptr, 0);
+    ASSERT_EQ(5, v.mMajor);
+    ASSERT_EQ(6, v.mMinor);
+    ASSERT_EQ(7, v.mPatch);
+    ASSERT_STREQ("test3", v.mPreRelease.c_str());
+    ASSERT_EQ(0, v.mBuild.length());
+    // the capacity is reused
+    ASSERT_EQ(preData, v.mPreRelease.data());
+    ASSERT_EQ(buildData, v.mBuild.data());
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(SemVersion, bump) {
+    SemVersion v(1, 2, 3, "test1", "test2");
+    v.bumpPatch();
+    ASSERT_STREQ("1.2.4", v.toString(true, true).c_str());
+    v.bumpMinor();
+    ASSERT_STREQ("1.3.0", v.toString(true, true).c_str());
+    v.set(1, 3, 0, "rc", "build");
+    v.bumpMajor();
+    ASSERT_STREQ("2.0.0", v.toString(true, true).c_str());
+}
+
+TEST(SemVersion, bump_max) {
+    SemVersion v(4294967295u, 4294967295u, 4294967295u, "rc", "b");
+    ASSERT_FALSE(v.bumpPatch());
+    ASSERT_FALSE(v.bumpMinor());
+    ASSERT_FALSE(v.bumpMajor());
+    ASSERT_STREQ("4294967295.4294967295.4294967295-rc+b", v.toString(true, true).c_str());
+    ASSERT_TRUE(v.bumpPreRelease());
+    ASSERT_STREQ("4294967295.4294967295.4294967295-rc.0", v.toString(true, true).c_str());
+
+    v.set(4294967295u, 4294967295u, 4294967295u);
+    ASSERT_FALSE(v.bumpPreRelease());
+    ASSERT_STREQ("4294967295.4294967295.4294967295", v.toString(true, true).c_str());
+    v.set(1, 4294967295u, 4294967295u);
+    ASSERT_TRUE(v.bumpMajor());
+    ASSERT_STREQ("2.0.0", v.toString().c_str());
+    v.set(1, 2, 4294967295u);
+    ASSERT_TRUE(v.bumpMinor());
+    ASSERT_STREQ("1.3.0", v.toString().c_str());
+}
+
+TEST(SemVersion, bumpPreRelease) {
+    SemVersion v(1, 2, 3);
+    v.bumpPreRelease();
+    ASSERT_STREQ("1.2.4-0", v.toString(true, true).c_str());
+
+    v.set(1, 2, 3, "rc.9", "build");
+    v.bumpPreRelease();
+    ASSERT_STREQ("1.2.3-rc.10", v.toString(true, true).c_str());
+    v.bumpPreRelease();
+    ASSERT_STREQ("1.2.3-rc.11", v.toString(true, true).c_str());
+
+    v.set(1, 2, 3, "99", "");
+    v.bumpPreRelease();
+    ASSERT_STREQ("1.2.3-100", v.toString(true, true).c_str());
+
+    v.set(1, 2, 3, "beta", "");
+    v.bumpPreRelease();
+    ASSERT_STREQ("1.2.3-beta.0", v.toString(true, true).c_str());
+}
+
+TEST(SemVersion, bumpPreRelease_capacity) {
+    SemVersion v(1, 2, 3, "rc.1", "");
+    v.mPreRelease.reserve(64);
+    const char * data = v.mPreRelease.data();
+    for (int i = 0; i < 1000; ++i) {
+        v.bumpPreRelease();
+    }
+    ASSERT_STREQ("rc.1001", v.mPreRelease.c_str());
+    ASSERT_EQ(data, v.mPreRelease.data());
+    ASSERT_EQ(0, v.comparePrecedence(SemVersion(1, 2, 3, "rc.1001", "")));
+}
+
 /**************************************************************************************************/
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /**************************************************************************************************/
@@ -380,6 +488,24 @@ TEST(SemVersion, parse_8) {
     ASSERT_EQ(0, v.mBuild.length());
 }
 
+TEST(SemVersion, parse_9) {
+    SemVersion v = SemVersion::parse("4294967295.0.1-test1+test2 tail", 26);
+    ASSERT_TRUE(v);
+    ASSERT_EQ(4294967295u, v.mMajor);
+    ASSERT_EQ(0, v.mMinor);
+    ASSERT_EQ(1, v.mPatch);
+    ASSERT_STREQ("test1", v.mPreRelease.c_str());
+    ASSERT_STREQ("test2", v.mBuild.c_str());
+}
+
+TEST(SemVersion, parse_10) {
+    SemVersion v = SemVersion::parse("4294967296.0.1");
+    ASSERT_FALSE(v);
+    ASSERT_EQ(0, v.mMajor);
+    ASSERT_EQ(0, v.mMinor);
+    ASSERT_EQ(0, v.mPatch);
+}
+
 /**************************************************************************************************/
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /**************************************************************************************************/
@@ -407,3 +533,176 @@ TEST(SemVersion, toString_case4) {
 /**************************************************************************************************/
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /**************************************************************************************************/
+
+TEST(SemVersion, isValid_cases) {
+    ASSERT_TRUE(SemVersion::isValid("0.0.0"));
+    ASSERT_TRUE(SemVersion::isValid("1.2.3"));
+    ASSERT_TRUE(SemVersion::isValid("10.20.30-test1.test1+test2.test2"));
+    ASSERT_TRUE(SemVersion::isValid("1.2.3-RC.1"));
+    ASSERT_TRUE(SemVersion::isValid("1.2.3+build"));
+    ASSERT_TRUE(SemVersion::isValid("1.2.3--"));
+
+    ASSERT_FALSE(SemVersion::isValid(nullptr));
+    ASSERT_FALSE(SemVersion::isValid(""));
+    ASSERT_FALSE(SemVersion::isValid("1.2"));
+    ASSERT_FALSE(SemVersion::isValid("01.2.3"));
+    ASSERT_FALSE(SemVersion::isValid("1.2.3-"));
+    ASSERT_FALSE(SemVersion::isValid("1.2.3-+"));
+    ASSERT_FALSE(SemVersion::isValid("1.2.3-.test"));
+    ASSERT_FALSE(SemVersion::isValid("1.2.3-[test1]+[test2]"));
+    ASSERT_FALSE(SemVersion::isValid("1.2.3 "));
+}
+
+TEST(SemVersion, isValid_length) {
+    const char * str = "1.2.3-test1+test2";
+    ASSERT_TRUE(SemVersion::isValid(str, 5));
+    ASSERT_TRUE(SemVersion::isValid(str, 11));
+    ASSERT_FALSE(SemVersion::isValid(str, 12));
+    ASSERT_FALSE(SemVersion::isValid(str, 4));
+}
+
+TEST(SemVersion, isValid_long_tags) {
+    // the tags are longer than one scanner word, a bad char is put to each position.
+    const std::string base = "1.2.3-abcdefghijklmnopqrstuvwxyz.ABCDEFGHIJKLMNOPQRSTUVWXYZ.0123456789-";
+    ASSERT_TRUE(SemVersion::isValid(base));
+    ASSERT_TRUE(SemVersion::isValid(base + "+" + base.substr(6)));
+    for (std::size_t i = 7; i < base.length(); ++i) {
+        std::string str = base;
+        str[i] = '_';
+        ASSERT_FALSE(SemVersion::isValid(str)) << str;
+        str[i] = static_cast<char>(0xC0);
+        ASSERT_FALSE(SemVersion::isValid(str)) << str;
+        str[i] = '+';
+        const bool validBuild = i + 1 != base.length() && base[i + 1] != '.';
+        ASSERT_EQ(validBuild, SemVersion::isValid(str)) << str;
+    }
+}
+
+TEST(SemVersion, isValid_matches_regex) {
+    const std::regex regex("^(0|[1-9][0-9]*)"
+                           "\\.(0|[1-9][0-9]*)"
+                           "\\.(0|[1-9][0-9]*)"
+                           "(?:\\-([0-9a-z-]+[\\.0-9a-z-]*))?"
+                           "(?:\\+([0-9a-z-]+[\\.0-9a-z-]*))?",
+                           std::regex_constants::ECMAScript | std::regex_constants::icase);
+    const char alphabet[] = {'0', '1', '9', '.', '-', '+', 'a', 'Z', '_'};
+    std::string str = "1.0.";
+    // all strings of 0-4 chars from the alphabet after the prefix
+    std::size_t combinations = 1;
+    std::size_t checked = 0;
+    for (std::size_t length = 0; length <= 4; ++length) {
+        for (std::size_t n = 0; n < combinations; ++n) {
+            str.resize(4);
+            std::size_t c = n;
+            for (std::size_t i = 0; i < length; ++i) {
+                str.push_back(alphabet[c % sizeof(alphabet)]);
+                c /= sizeof(alphabet);
+            }
+            ASSERT_EQ(std::regex_match(str, regex), SemVersion::isValid(str)) << str;
+            ++checked;
+        }
+        combinations *= sizeof(alphabet);
+    }
+    ASSERT_EQ(1 + 9 + 81 + 729 + 6561, checked);
+}
+
+TEST(SemVersion, isValidBatch) {
+    const char * versions[] = {"1.2.3", "1.2", nullptr, "1.2.3-test1+test2"};
+    bool results[4] = {};
+    ASSERT_EQ(2, SemVersion::isValidBatch(versions, nullptr, results, 4));
+    ASSERT_TRUE(results[0]);
+    ASSERT_FALSE(results[1]);
+    ASSERT_FALSE(results[2]);
+    ASSERT_TRUE(results[3]);
+
+    const std::size_t lengths[] = {3, 3, 0, 11};
+    ASSERT_EQ(1, SemVersion::isValidBatch(versions, lengths, nullptr, 4));
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(SemVersion, parseLenient) {
+    struct Case {
+        const char * mString;
+        const char * mExpected;
+        std::uint8_t mApplied;
+    };
+    const Case cases[] = {
+        {"1.2.3-rc.1+b", "1.2.3-rc.1+b", SemVersion::LenientNone},
+        {"v1.2.3", "1.2.3", SemVersion::LenientPrefix},
+        {"V1.2.3", "1.2.3", SemVersion::LenientPrefix},
+        {"=1.2.3", "1.2.3", SemVersion::LenientPrefix},
+        {"=v1.2.3", "1.2.3", SemVersion::LenientPrefix},
+        {"1.2", "1.2.0", SemVersion::LenientMissingPatch},
+        {"1", "1.0.0", SemVersion::LenientMissingMinor},
+        {"1.2-beta+b", "1.2.0-beta+b", SemVersion::LenientMissingPatch},
+        {" \t1.2.3\r\n", "1.2.3", SemVersion::LenientWhitespace},
+        {"\f1.2.3\v", "1.2.3", SemVersion::LenientWhitespace},
+        {" v2 ", "2.0.0", SemVersion::LenientPrefix | SemVersion::LenientMissingMinor | SemVersion::LenientWhitespace},
+    };
+    for (auto & c : cases) {
+        SemVersion ver;
+        std::uint8_t applied = 0xFF;
+        ASSERT_TRUE(SemVersion::parseLenient(c.mString, std::strlen(c.mString), ver, SemVersion::LenientAll, &applied)) << c.mString;
+        ASSERT_EQ(c.mApplied, applied) << c.mString;
+        ASSERT_STREQ(c.mExpected, ver.toString(true, true).c_str()) << c.mString;
+        // the flags which were applied are enough
+        ASSERT_TRUE(SemVersion::parseLenient(c.mString, std::strlen(c.mString), ver, c.mApplied, nullptr)) << c.mString;
+    }
+
+    const char * invalid[] = {"", " ", "v", "=", "vv1.2.3", "v=1.2.3", "1.", "1.2.", "01.2", "1 .2.3", "1.2.3-", "x1.2.3", "1.2.3 x"};
+    for (auto str : invalid) {
+        SemVersion ver(1, 2, 3);
+        std::uint8_t applied = 0xFF;
+        ASSERT_FALSE(SemVersion::parseLenient(str, std::strlen(str), ver, SemVersion::LenientAll, &applied)) << str;
+        ASSERT_EQ(SemVersion::LenientNone, applied) << str;
+        ASSERT_STREQ("0.0.0", ver.toString().c_str()) << str;
+    }
+
+    // only the allowed flags
+    ASSERT_FALSE(SemVersion::parseLenient("v1.2.3", SemVersion::LenientWhitespace));
+    ASSERT_FALSE(SemVersion::parseLenient("1", SemVersion::LenientMissingPatch));
+    ASSERT_FALSE(SemVersion::parseLenient("1.2", SemVersion::LenientMissingMinor));
+    ASSERT_TRUE(SemVersion::parseLenient("1", SemVersion::LenientMissingMinor));
+    ASSERT_STREQ("1.0.0-rc", SemVersion::parseLenient("1-rc", SemVersion::LenientMissingMinor).toString(true).c_str());
+    ASSERT_FALSE(SemVersion::parseLenient(" 1.2.3", SemVersion::LenientPrefix));
+    ASSERT_FALSE(SemVersion::parse("v1.2.3"));
+    ASSERT_FALSE(SemVersion::parse("1.2"));
+    ASSERT_TRUE(SemVersion::parseLenient("1.2", SemVersion::LenientMissingPatch));
+    ASSERT_FALSE(SemVersion::parseLenient("1.2.99999999999"));
+}
+
+TEST(SemVersion, comparePrecedence) {
+    // the example from the semver.org
+    const char * ordered[] = {
+        "1.0.0-alpha", "1.0.0-alpha.1", "1.0.0-alpha.beta", "1.0.0-beta", "1.0.0-beta.2",
+        "1.0.0-beta.11", "1.0.0-rc.1", "1.0.0", "1.0.1", "1.1.0", "2.0.0",
+    };
+    const std::size_t count = sizeof(ordered) / sizeof(ordered[0]);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t j = 0; j < count; ++j) {
+            const int res = SemVersion::parse(ordered[i]).comparePrecedence(SemVersion::parse(ordered[j]));
+            if (i < j) {
+                ASSERT_LT(res, 0) << ordered[i] << " " << ordered[j];
+            }
+            else if (i > j) {
+                ASSERT_GT(res, 0) << ordered[i] << " " << ordered[j];
+            }
+            else {
+                ASSERT_EQ(0, res) << ordered[i];
+            }
+        }
+    }
+}
+
+TEST(SemVersion, comparePrecedence_build_ignored) {
+    ASSERT_EQ(0, SemVersion(1, 2, 3, "rc.1", "build1").comparePrecedence(SemVersion(1, 2, 3, "rc.1", "build2")));
+    ASSERT_EQ(0, SemVersion(1, 2, 3, "rc.01", "").comparePrecedence(SemVersion(1, 2, 3, "rc.1", "")));
+    ASSERT_LT(SemVersion(1, 2, 3, "rc.9", "").comparePrecedence(SemVersion(1, 2, 3, "rc.10", "")), 0);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
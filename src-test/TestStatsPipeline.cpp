@@ -0,0 +1,221 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <stdexcept>
+#include <algorithm>
+#include <sstream>
+#include <cstring>
+#include "gtest/gtest.h"
+#include "sts/semver/StatsPipeline.h"
+
+using namespace sts::semver;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+namespace {
+
+    std::string makeLog(const std::size_t count) {
+        std::ostringstream stream;
+        for (std::size_t i = 0; i < count; ++i) {
+            stream << (i % 3) << '.' << (i % 5) << '.' << i;
+            if (i % 4 == 0) {
+                stream << "-rc." << (i % 7);
+            }
+            stream << (i % 2 ? '\n' : ' ');
+            if (i % 50 == 0) {
+                stream << "bad.version ";
+            }
+        }
+        return stream.str();
+    }
+
+    StatsPipeline::Reader makeReader(const std::string & input, std::size_t & pos) {
+        return [&input, &pos](char * buffer, const std::size_t size) {
+            // small portions to check chunks which are filled by several reads
+            const std::size_t read = std::min<std::size_t>(std::min<std::size_t>(size, 100), input.length() - pos);
+            std::memcpy(buffer, input.data() + pos, read);
+            pos += read;
+            return read;
+        };
+    }
+
+    void assertStats(const VersionStats & stats) {
+        ASSERT_EQ(1000, stats.mTotal);
+        ASSERT_EQ(250, stats.mPreReleaseCount);
+        ASSERT_EQ(20, stats.mInvalidCount);
+        ASSERT_DOUBLE_EQ(0.25, stats.preReleaseShare());
+        ASSERT_EQ(3, stats.mMajorCounts.size());
+        ASSERT_EQ(334, stats.mMajorCounts.at(0));
+        ASSERT_EQ(333, stats.mMajorCounts.at(1));
+        ASSERT_EQ(15, stats.mMinorCounts.size());
+        ASSERT_EQ(67, stats.mMinorCounts.at(std::make_pair(0u, 0u)));
+        ASSERT_STREQ("2.4.989", stats.mNewest.toString(true, true).c_str());
+    }
+
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(VersionStats, add_merge) {
+    VersionStats s1;
+    s1.add(SemVersion(1, 2, 3));
+    s1.add(SemVersion(1, 3, 0, "rc.1", ""));
+    VersionStats s2;
+    s2.add(SemVersion(1, 3, 0));
+    s2.mInvalidCount = 2;
+    s1.merge(s2);
+    s1.merge(VersionStats());
+    ASSERT_EQ(3, s1.mTotal);
+    ASSERT_EQ(1, s1.mPreReleaseCount);
+    ASSERT_EQ(2, s1.mInvalidCount);
+    ASSERT_EQ(3, s1.mMajorCounts.at(1));
+    ASSERT_EQ(2, s1.mMinorCounts.at(std::make_pair(1u, 3u)));
+    ASSERT_STREQ("1.3.0", s1.mNewest.toString(true, true).c_str());
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(StatsPipeline, reader) {
+    const std::string input = makeLog(1000);
+    for (std::size_t threads = 1; threads <= 4; ++threads) {
+        for (std::size_t chunkSize : {16, 64, 1000, 100000}) {
+            std::size_t pos = 0;
+            StatsPipeline::Config config;
+            config.mThreads = threads;
+            config.mChunkSize = chunkSize;
+            config.mQueueSize = 2;
+            assertStats(StatsPipeline::run(makeReader(input, pos), config));
+        }
+    }
+}
+
+TEST(StatsPipeline, memory) {
+    const std::string input = makeLog(1000);
+    for (std::size_t threads = 1; threads <= 4; ++threads) {
+        // the same chunk sizes as for the reader, a token longer than a chunk is invalid
+        for (std::size_t chunkSize : {16, 64, 1000, 100000}) {
+            StatsPipeline::Config config;
+            config.mThreads = threads;
+            config.mChunkSize = chunkSize;
+            assertStats(StatsPipeline::run(input.data(), input.length(), config));
+        }
+    }
+}
+
+TEST(StatsPipeline, filter) {
+    const std::string input = makeLog(1000);
+    StatsPipeline::Config config;
+    config.mFilter = [](const SemVersion & v) { return v.mMajor == 1; };
+    const VersionStats stats = StatsPipeline::run(input.data(), input.length(), config);
+    ASSERT_EQ(333, stats.mTotal);
+    ASSERT_EQ(1, stats.mMajorCounts.size());
+}
+
+TEST(StatsPipeline, long_tokens) {
+    const std::string input = "1.2.3 1.2.3-" + std::string(100, 'a') + "1.2.3 4.5.6";
+    std::size_t pos = 0;
+    StatsPipeline::Config config;
+    config.mThreads = 2;
+    config.mChunkSize = 16;
+    const VersionStats stats = StatsPipeline::run(makeReader(input, pos), config);
+    ASSERT_EQ(2, stats.mTotal);
+    ASSERT_EQ(1, stats.mInvalidCount);
+    ASSERT_STREQ("4.5.6", stats.mNewest.toString().c_str());
+}
+
+TEST(StatsPipeline, long_tokens_same_rule) {
+    // tokens around the chunk size, the ones longer than the chunk are invalid in both versions
+    std::string input;
+    for (std::size_t i = 0; i < 40; ++i) {
+        input += "1.2.3-" + std::string(6 + i % 7, 'a') + (i % 3 ? " " : "\n\n");
+    }
+    StatsPipeline::Config config;
+    config.mThreads = 2;
+    config.mChunkSize = 16;
+    std::size_t pos = 0;
+    const VersionStats fromReader = StatsPipeline::run(makeReader(input, pos), config);
+    const VersionStats fromMemory = StatsPipeline::run(input.data(), input.length(), config);
+    // lengths 12..18, 5 of 7 fit 16
+    ASSERT_EQ(30, fromReader.mTotal);
+    ASSERT_EQ(10, fromReader.mInvalidCount);
+    ASSERT_EQ(fromReader.mTotal, fromMemory.mTotal);
+    ASSERT_EQ(fromReader.mInvalidCount, fromMemory.mInvalidCount);
+}
+
+TEST(StatsPipeline, exception_stops_reading) {
+    // a big input, the reader must not be called until its end after the filter fails
+    const std::size_t total = std::size_t(1) << 30;
+    std::size_t pos = 0;
+    const StatsPipeline::Reader reader = [&pos, total](char * buffer, const std::size_t size) -> std::size_t {
+        const std::size_t read = std::min<std::size_t>(size - size % 6, total - pos);
+        for (std::size_t i = 0; i < read; i += 6) {
+            std::memcpy(buffer + i, "1.2.3 ", 6);
+        }
+        pos += read;
+        return read;
+    };
+    StatsPipeline::Config config;
+    config.mThreads = 2;
+    config.mChunkSize = 64 * 1024;
+    config.mFilter = [](const SemVersion &) -> bool {
+        throw std::runtime_error("filter");
+    };
+    ASSERT_THROW(StatsPipeline::run(reader, config), std::runtime_error);
+    ASSERT_LT(pos, std::size_t(64) * config.mChunkSize);
+}
+
+TEST(StatsPipeline, exceptions) {
+    const std::string input = makeLog(1000);
+    StatsPipeline::Config config;
+    config.mThreads = 2;
+    config.mChunkSize = 64;
+    config.mFilter = [](const SemVersion & v) -> bool {
+        if (v.mPatch == 500) {
+            throw std::runtime_error("filter");
+        }
+        return true;
+    };
+    ASSERT_THROW(StatsPipeline::run(input.data(), input.length(), config), std::runtime_error);
+
+    config.mFilter = nullptr;
+    const StatsPipeline::Reader reader = [](char *, std::size_t) -> std::size_t {
+        throw std::runtime_error("reader");
+    };
+    ASSERT_THROW(StatsPipeline::run(reader, config), std::runtime_error);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
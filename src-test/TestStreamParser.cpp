@@ -0,0 +1,139 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "sts/semver/StreamParser.h"
+
+using namespace sts::semver;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+namespace {
+
+    std::vector<std::string> parseChunks(StreamParser & parser, std::vector<SemVersion> & out,
+                                         const std::string & input, const std::size_t chunkSize) {
+        std::vector<std::string> res;
+        for (std::size_t i = 0; i < input.length(); i += chunkSize) {
+            const std::string chunk = input.substr(i, chunkSize);
+            parser.feed(chunk.data(), chunk.length());
+        }
+        parser.finish();
+        for (auto & v : out) {
+            res.emplace_back(v.toString(true, true));
+        }
+        return res;
+    }
+
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(StreamParser, single_chunk) {
+    std::vector<SemVersion> out;
+    StreamParser parser([&](const SemVersion & v) { out.emplace_back(v); });
+    const std::string input = "1.2.3 4.5.6-test1\n7.8.9+test2\t10.11.12-test1.test1+test2.test2";
+    ASSERT_EQ(3, parser.feed(input.data(), input.length()));
+    ASSERT_EQ(1, parser.finish());
+    ASSERT_EQ(4, out.size());
+    ASSERT_STREQ("1.2.3", out[0].toString(true, true).c_str());
+    ASSERT_STREQ("4.5.6-test1", out[1].toString(true, true).c_str());
+    ASSERT_STREQ("7.8.9+test2", out[2].toString(true, true).c_str());
+    ASSERT_STREQ("10.11.12-test1.test1+test2.test2", out[3].toString(true, true).c_str());
+    ASSERT_EQ(4, parser.parsedCount());
+    ASSERT_EQ(0, parser.invalidCount());
+}
+
+TEST(StreamParser, any_chunk_size) {
+    const std::string input = "  1.2.3-abcdefghijklmnopqrstuvwxyz.0123456789+build.20180805 \n"
+            "01.2.3 1.2.3-+ 1.2.3-[test1] 1.2 0.0.0 4294967295.0.1 4294967296.0.1 1.2.3-.a 1.2.3-a+b+c 3.2.1";
+    for (std::size_t chunkSize = 1; chunkSize <= input.length(); ++chunkSize) {
+        std::vector<SemVersion> out;
+        StreamParser parser([&](const SemVersion & v) { out.emplace_back(v); });
+        const auto res = parseChunks(parser, out, input, chunkSize);
+        ASSERT_EQ(4, res.size()) << chunkSize;
+        ASSERT_STREQ("1.2.3-abcdefghijklmnopqrstuvwxyz.0123456789+build.20180805", res[0].c_str());
+        ASSERT_STREQ("0.0.0", res[1].c_str());
+        ASSERT_STREQ("4294967295.0.1", res[2].c_str());
+        ASSERT_STREQ("3.2.1", res[3].c_str());
+        ASSERT_EQ(7, parser.invalidCount()) << chunkSize;
+    }
+}
+
+TEST(StreamParser, matches_isValid) {
+    const char * tokens[] = {
+        "1.2.3", "0.0.0", "1.2.3-a", "1.2.3--", "1.2.3-a.", "1.2.3+a-b", "1.2.3-RC.1+Z",
+        "1.2", "1.2.3.", "1.2.3-", "1.2.3+", "v1.2.3", "1..3", "00.1.2", "1.2.3-a_b", "1.2.3-+a",
+    };
+    for (auto token : tokens) {
+        std::size_t count = 0;
+        StreamParser parser([&](const SemVersion &) { ++count; });
+        parser.feed(token, std::strlen(token));
+        parser.finish();
+        ASSERT_EQ(SemVersion::isValid(token) ? 1 : 0, count) << token;
+        ASSERT_EQ(SemVersion::isValid(token) ? 0 : 1, parser.invalidCount()) << token;
+    }
+}
+
+TEST(StreamParser, max_tag_length) {
+    std::vector<SemVersion> out;
+    StreamParser parser([&](const SemVersion & v) { out.emplace_back(v); }, 4);
+    const std::string input = "1.2.3-abcd+abcd 1.2.3-abcde 1.2.3+abcde 1.2.3";
+    for (const char ch : input) {
+        parser.feed(&ch, 1);
+    }
+    parser.finish();
+    ASSERT_EQ(2, out.size());
+    ASSERT_STREQ("1.2.3-abcd+abcd", out[0].toString(true, true).c_str());
+    ASSERT_STREQ("1.2.3", out[1].toString(true, true).c_str());
+    ASSERT_EQ(2, parser.invalidCount());
+}
+
+TEST(StreamParser, reset) {
+    std::size_t count = 0;
+    StreamParser parser([&](const SemVersion &) { ++count; });
+    parser.feed("1.2.3 x 1.2", 11);
+    ASSERT_EQ(1, parser.parsedCount());
+    ASSERT_EQ(1, parser.invalidCount());
+    parser.reset();
+    ASSERT_EQ(0, parser.parsedCount());
+    ASSERT_EQ(0, parser.invalidCount());
+    parser.feed(".3", 2);
+    parser.finish();
+    ASSERT_EQ(1, count);
+    ASSERT_EQ(1, parser.invalidCount());
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
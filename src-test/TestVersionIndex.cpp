@@ -0,0 +1,231 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <atomic>
+#include <random>
+#include <thread>
+#include "gtest/gtest.h"
+#include "sts/semver/VersionIndex.h"
+#include "RandomVersions.h"
+
+using namespace sts::semver;
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+TEST(VersionIndex, empty) {
+    const VersionIndex invalid;
+    ASSERT_FALSE(invalid.isValid());
+
+    const auto data = VersionIndex::build({});
+    const VersionIndex index(data.data(), data.size());
+    ASSERT_TRUE(index.isValid());
+    ASSERT_TRUE(index.empty());
+    ASSERT_EQ(0, index.lowerBound(SemVersion(1, 0, 0)));
+    ASSERT_TRUE(index.find(SemVersion(1, 0, 0)) == VersionIndex::npos);
+    ASSERT_TRUE(index.maxSatisfying(Range::parse("*")) == VersionIndex::npos);
+}
+
+TEST(VersionIndex, sorted_unique) {
+    const auto versions = randomVersions(3000);
+    const auto expected = sortedUnique(versions);
+    const auto data = VersionIndex::build(versions);
+    const VersionIndex index(data.data(), data.size());
+    ASSERT_TRUE(index.isValid());
+    ASSERT_EQ(expected.size(), index.size());
+    SemVersion version;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        index.version(i, version);
+        ASSERT_TRUE(equalVersion(expected[i], version)) << i << " " << version.toString(true, true);
+    }
+}
+
+TEST(VersionIndex, find) {
+    const auto versions = randomVersions(3000);
+    const auto expected = sortedUnique(versions);
+    const auto data = VersionIndex::build(versions);
+    const VersionIndex index(data.data(), data.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(i, index.find(expected[i]));
+    }
+    ASSERT_TRUE(index.find(SemVersion(7, 0, 0)) == VersionIndex::npos);
+    ASSERT_TRUE(index.find(SemVersion(1, 2, 3, "gamma", "")) == VersionIndex::npos);
+    ASSERT_TRUE(index.find(SemVersion(1, 2, 3, "", "build.3")) == VersionIndex::npos);
+}
+
+TEST(VersionIndex, bounds) {
+    const auto versions = randomVersions(3000);
+    const auto expected = sortedUnique(versions);
+    const auto data = VersionIndex::build(versions);
+    const VersionIndex index(data.data(), data.size());
+    std::mt19937 rnd(7);
+    for (int i = 0; i < 1000; ++i) {
+        const SemVersion v = randomVersion(rnd);
+        const auto lower = std::lower_bound(expected.begin(), expected.end(), v, [](const SemVersion & l, const SemVersion & r) {
+            return l.comparePrecedence(r) < 0;
+        });
+        const auto upper = std::upper_bound(expected.begin(), expected.end(), v, [](const SemVersion & l, const SemVersion & r) {
+            return l.comparePrecedence(r) < 0;
+        });
+        ASSERT_EQ(static_cast<std::size_t>(lower - expected.begin()), index.lowerBound(v)) << v.toString(true, true);
+        ASSERT_EQ(static_cast<std::size_t>(upper - expected.begin()), index.upperBound(v)) << v.toString(true, true);
+    }
+}
+
+TEST(VersionIndex, max_satisfying) {
+    const auto versions = randomVersions(3000);
+    const auto expected = sortedUnique(versions);
+    const auto data = VersionIndex::build(versions);
+    const VersionIndex index(data.data(), data.size());
+    const char * ranges[] = {
+        "*", "^1.2.3", "~2.5.0", "<1.0.0", "<=3.4.50", ">=4.19.99", ">4.19.99", "=2.3.4-beta.2",
+        "^0.1.0 || ^2.0.0", ">=1.0.0 <1.0.1", "^9.0.0", "1.2.3-rc.1 || 3.3.3", "invalid",
+    };
+    for (auto r : ranges) {
+        const Range range = Range::parse(r);
+        std::size_t naive = VersionIndex::npos;
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            if (range.contains(expected[i])) {
+                naive = i;
+            }
+        }
+        const std::size_t found = index.maxSatisfying(range);
+        // the versions with equal precedence are equally good
+        if (naive == VersionIndex::npos) {
+            ASSERT_TRUE(found == VersionIndex::npos) << r;
+        }
+        else {
+            ASSERT_TRUE(found != VersionIndex::npos) << r;
+            ASSERT_EQ(0, expected[naive].comparePrecedence(expected[found])) << r;
+            ASSERT_TRUE(range.contains(expected[found])) << r;
+        }
+    }
+}
+
+TEST(VersionIndex, position_independent) {
+    const auto versions = randomVersions(500);
+    const auto data = VersionIndex::build(versions);
+    // the copy at another address isn't aligned
+    std::vector<std::uint8_t> moved(data.size() + 3);
+    std::copy(data.begin(), data.end(), moved.begin() + 3);
+    const VersionIndex original(data.data(), data.size());
+    const VersionIndex index(moved.data() + 3, data.size());
+    ASSERT_TRUE(index.isValid());
+    ASSERT_EQ(original.size(), index.size());
+    for (std::size_t i = 0; i < index.size(); ++i) {
+        ASSERT_TRUE(equalVersion(original.version(i), index.version(i)));
+    }
+}
+
+TEST(VersionIndex, corrupted) {
+    const auto data = VersionIndex::build(randomVersions(100));
+    ASSERT_FALSE(VersionIndex(nullptr, 0).isValid());
+    ASSERT_FALSE(VersionIndex(data.data(), data.size() - 1).isValid());
+    ASSERT_FALSE(VersionIndex(data.data(), 10).isValid());
+
+    auto magic = data;
+    magic[0] = 'X';
+    ASSERT_FALSE(VersionIndex(magic.data(), magic.size()).isValid());
+
+    // format version follows the magic
+    auto format = data;
+    format[8] = static_cast<std::uint8_t>(VersionIndex::FormatVersion + 1);
+    ASSERT_FALSE(VersionIndex(format.data(), format.size()).isValid());
+
+    auto payload = data;
+    payload.back() ^= 0x20;
+    ASSERT_FALSE(VersionIndex(payload.data(), payload.size()).isValid());
+    ASSERT_TRUE(VersionIndex(payload.data(), payload.size(), false).isValid());
+
+    // pre-release offset of the first entry points out of the strings
+    auto offset = data;
+    offset[64 + 12 + 3] = 0x7F;
+    ASSERT_FALSE(VersionIndex(offset.data(), offset.size(), false).isValid());
+}
+
+TEST(VersionIndex, file) {
+    const char * path = "test-version-index.bin";
+    const auto versions = randomVersions(1000);
+    const auto expected = sortedUnique(versions);
+    ASSERT_TRUE(VersionIndex::write(versions, path));
+
+    VersionIndexFile file;
+    ASSERT_TRUE(file.open(path));
+    const VersionIndex & index = file.index();
+    ASSERT_TRUE(index.isValid());
+    ASSERT_EQ(expected.size(), index.size());
+    ASSERT_EQ(expected.size() - 1, index.maxSatisfying(Range::parse("*")));
+    ASSERT_EQ(10, index.find(expected[10]));
+    file.close();
+    ASSERT_FALSE(file.index().isValid());
+
+    ASSERT_FALSE(file.open("not-existing-version-index.bin"));
+    std::remove(path);
+}
+
+TEST(VersionIndex, file_concurrent_writers) {
+    const char * path = "test-version-index-concurrent.bin";
+    std::vector<std::vector<SemVersion>> sets;
+    for (unsigned i = 0; i < 4; ++i) {
+        sets.emplace_back(randomVersions(500 + i * 100, i));
+    }
+    std::vector<std::thread> writers;
+    std::atomic<int> failures(0);
+    for (auto & set : sets) {
+        writers.emplace_back([&set, &failures, path]() {
+            for (int n = 0; n < 10; ++n) {
+                if (!VersionIndex::write(set, path)) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    for (auto & w : writers) {
+        w.join();
+    }
+    ASSERT_EQ(0, failures.load());
+
+    // the file is one of the complete indexes
+    VersionIndexFile file;
+    ASSERT_TRUE(file.open(path));
+    bool found = false;
+    for (auto & set : sets) {
+        found = found || file.index().size() == sortedUnique(set).size();
+    }
+    ASSERT_TRUE(found);
+    file.close();
+    std::remove(path);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,98 @@
+# ----------------------------------------------------------------------------------#
+# //////////////////////////////////////////////////////////////////////////////////#
+# ----------------------------------------------------------------------------------#
+#
+#  Copyright (C) 2018, StepToSky
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#
+#  1.Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#  2.Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and / or other materials provided with the distribution.
+#  3.Neither the name of StepToSky nor the names of its
+#    contributors may be used to endorse or promote products derived from
+#    this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+#  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+#  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+#  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+#  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+#  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+#  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+#  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+#  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#  Contacts: www.steptosky.com
+#
+# ----------------------------------------------------------------------------------#
+# //////////////////////////////////////////////////////////////////////////////////#
+# ----------------------------------------------------------------------------------#
+
+# Compares the tool with the coreutils equivalents.
+# usage: python benchmark.py <path to the tool> [versions count]
+
+import os
+import random
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def generate(path, count):
+    rnd = random.Random(1)
+    with open(path, 'w') as f:
+        for _ in range(count):
+            v = '%d.%d.%d' % (rnd.randint(0, 20), rnd.randint(0, 50), rnd.randint(0, 200))
+            r = rnd.random()
+            if r < 0.2:
+                v += '-rc.%d' % rnd.randint(0, 12)
+            elif r < 0.25:
+                v += '-beta'
+            if rnd.random() < 0.1:
+                v += '+b%d' % rnd.randint(0, 99)
+            f.write(v + '\n')
+
+
+def measure(command):
+    start = time.time()
+    with open(os.devnull, 'w') as null:
+        subprocess.call(command, shell=True, stdout=null)
+    return time.time() - start
+
+
+def main():
+    if len(sys.argv) < 2:
+        print('usage: python benchmark.py <path to the tool> [versions count]')
+        return 2
+    tool = sys.argv[1]
+    count = int(sys.argv[2]) if len(sys.argv) > 2 else 2000000
+    path = os.path.join(tempfile.gettempdir(), 'sts-semver-benchmark.txt')
+    generate(path, count)
+
+    regex = "'^(0|[1-9][0-9]*)\\.(0|[1-9][0-9]*)\\.(0|[1-9][0-9]*)(-[0-9A-Za-z-]+[.0-9A-Za-z-]*)?(\\+[0-9A-Za-z-]+[.0-9A-Za-z-]*)?$'"
+    cases = [
+        ('sort', 'sort -V %s' % path, '%s sort %s' % (tool, path)),
+        ('max', 'sort -V %s | tail -n 1' % path, '%s max %s' % (tool, path)),
+        ('min', 'sort -V %s | head -n 1' % path, '%s min %s' % (tool, path)),
+        ('uniq', 'sort -uV %s' % path, '%s uniq %s' % (tool, path)),
+        ('validate', 'grep -vE %s %s' % (regex, path), '%s validate %s' % (tool, path)),
+        # the versions are validated before the major number is checked, as the tool does
+        ('filter', "grep -E %s %s | awk -F. '$1 == 1'" % (regex, path), "%s filter '>=1.0.0-0 <2.0.0-0' %s" % (tool, path)),
+    ]
+    print('%d versions' % count)
+    print('%-10s %12s %12s' % ('command', 'coreutils', 'tool'))
+    for name, coreutils, ours in cases:
+        print('%-10s %11.3fs %11.3fs' % (name, measure(coreutils), measure(ours)))
+    os.remove(path)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,493 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#   include <io.h>
+#   include <fcntl.h>
+#else
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+#include "sts/semver/Info.h"
+#include "sts/semver/SemVersion.h"
+#include "sts/semver/Range.h"
+#include "Scanner.h"
+
+using namespace sts::semver;
+using scanner::isDelimiter;
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Input *////////////////////////////////////////////////
+/**************************************************************************************************/
+
+/*
+ * Sequential reading of a file or stdin by chunks.
+ * A read from a pipe returns what is available, so the tool can work in a pipeline.
+ */
+class Input {
+public:
+
+    Input() = default;
+    Input(const Input &) = delete;
+    Input & operator=(const Input &) = delete;
+
+    ~Input() {
+        if (mFd != -1 && mOwned) {
+#ifdef _WIN32
+            _close(mFd);
+#else
+            ::close(mFd);
+#endif
+        }
+    }
+
+    bool open(const char * path) {
+        if (!path) {
+#ifdef _WIN32
+            _setmode(0, _O_BINARY);
+#endif
+            mFd = 0;
+            return true;
+        }
+#ifdef _WIN32
+        mFd = _open(path, _O_RDONLY | _O_BINARY);
+#else
+        mFd = ::open(path, O_RDONLY);
+#endif
+        mOwned = true;
+        return mFd != -1;
+    }
+
+    /*
+     * Returns false if there is an error, outRead is 0 at the end of the input.
+     */
+    bool read(char * buffer, const std::size_t size, std::size_t & outRead) {
+        for (;;) {
+#ifdef _WIN32
+            const int res = _read(mFd, buffer, static_cast<unsigned>(size));
+#else
+            const ssize_t res = ::read(mFd, buffer, size);
+#endif
+            if (res >= 0) {
+                outRead = static_cast<std::size_t>(res);
+                return true;
+            }
+            if (errno != EINTR) {
+                return false;
+            }
+        }
+    }
+
+    /*
+     * Reads the rest of the input into the buffer.
+     */
+    bool readAll(std::vector<char> & outBuffer) {
+        std::size_t read = 0;
+        do {
+            const std::size_t size = outBuffer.size();
+            outBuffer.resize(size + mChunkSize);
+            if (!this->read(outBuffer.data() + size, mChunkSize, read)) {
+                return false;
+            }
+            outBuffer.resize(size + read);
+        } while (read != 0);
+        return true;
+    }
+
+    std::size_t chunkSize() const {
+        return mChunkSize;
+    }
+
+private:
+
+    const std::size_t mChunkSize = 64 * 1024;
+    int mFd = -1;
+    bool mOwned = false;
+
+};
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Output *///////////////////////////////////////////////
+/**************************************************************************************************/
+
+class Output {
+public:
+
+    Output() {
+        mBuffer.reserve(mCapacity);
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    }
+
+    Output(const Output &) = delete;
+    Output & operator=(const Output &) = delete;
+
+    ~Output() {
+        flush();
+    }
+
+    void line(const char * data, const std::size_t length) {
+        if (mBuffer.size() + length + 1 > mCapacity) {
+            flush();
+        }
+        mBuffer.insert(mBuffer.end(), data, data + length);
+        mBuffer.push_back('\n');
+    }
+
+    void flush() {
+        if (!mBuffer.empty()) {
+            std::fwrite(mBuffer.data(), 1, mBuffer.size(), stdout);
+            mBuffer.clear();
+        }
+        std::fflush(stdout);
+    }
+
+private:
+
+    const std::size_t mCapacity = 256 * 1024;
+    std::vector<char> mBuffer;
+
+};
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Parsing *//////////////////////////////////////////////
+/**************************************************************************************************/
+
+struct Entry {
+    SemVersion mVersion;
+    // The original text, it is printed as is.
+    const char * mText;
+    std::size_t mLength;
+};
+
+void parseSlice(const char * ptr, const char * end, std::vector<Entry> & outEntries) {
+    Entry entry;
+    while (ptr != end) {
+        while (ptr != end && isDelimiter(*ptr)) {
+            ++ptr;
+        }
+        const char * begin = ptr;
+        while (ptr != end && !isDelimiter(*ptr)) {
+            ++ptr;
+        }
+        if (begin == ptr) {
+            break;
+        }
+        entry.mText = begin;
+        entry.mLength = static_cast<std::size_t>(ptr - begin);
+        if (SemVersion::parse(begin, entry.mLength, entry.mVersion)) {
+            outEntries.emplace_back(std::move(entry));
+        }
+    }
+}
+
+// The buffer is split into slices on whitespace boundaries, each slice is parsed by own thread.
+std::vector<Entry> parse(const std::vector<char> & buffer, const std::size_t threads) {
+    const char * data = buffer.data();
+    const char * end = data + buffer.size();
+    std::vector<const char *> bounds(1, data);
+    for (std::size_t i = 1; i < threads; ++i) {
+        const char * bound = std::max(bounds.back(), data + buffer.size() * i / threads);
+        while (bound != end && !isDelimiter(*bound)) {
+            ++bound;
+        }
+        bounds.push_back(bound);
+    }
+    bounds.push_back(end);
+
+    std::vector<std::vector<Entry>> parts(threads);
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers.emplace_back(parseSlice, bounds[i], bounds[i + 1], std::ref(parts[i]));
+    }
+    for (auto & w : workers) {
+        w.join();
+    }
+
+    std::vector<Entry> res = std::move(parts[0]);
+    for (std::size_t i = 1; i < threads; ++i) {
+        std::move(parts[i].begin(), parts[i].end(), std::back_inserter(res));
+    }
+    return res;
+}
+
+/*
+ * Calls the handler for each token of the input without loading the whole input,
+ * a token which is split between the chunks is joined in a separate buffer.
+ * A token which is longer than the chunk size is invalid, the optional tooLong handler
+ * is called with its beginning and the rest of it is skipped, so the memory doesn't depend on the input.
+ * The output is flushed after each chunk.
+ */
+bool forEachToken(Input & input, Output & output, const std::function<void(const char *, std::size_t)> & handler,
+                  const std::function<void(const char *, std::size_t)> & tooLong = nullptr) {
+    const std::size_t maxLength = input.chunkSize();
+    std::vector<char> chunk(input.chunkSize());
+    std::string carry;
+    bool skipping = false;
+    std::size_t read = 0;
+    while (input.read(chunk.data(), chunk.size(), read)) {
+        if (read == 0) {
+            if (!carry.empty()) {
+                handler(carry.data(), carry.length());
+            }
+            return true;
+        }
+        const char * ptr = chunk.data();
+        const char * end = ptr + read;
+        while (ptr != end) {
+            const char * begin = ptr;
+            while (ptr != end && !isDelimiter(*ptr)) {
+                ++ptr;
+            }
+            const std::size_t length = static_cast<std::size_t>(ptr - begin);
+            if (skipping) {
+                // the rest of the too long token
+            }
+            else if (carry.length() + length > maxLength) {
+                carry.append(begin, maxLength - carry.length());
+                if (tooLong) {
+                    tooLong(carry.data(), carry.length());
+                }
+                carry.clear();
+                skipping = true;
+            }
+            else if (ptr == end) {
+                carry.append(begin, ptr);
+            }
+            else if (!carry.empty()) {
+                carry.append(begin, ptr);
+                handler(carry.data(), carry.length());
+                carry.clear();
+            }
+            else if (length != 0) {
+                handler(begin, length);
+            }
+            if (ptr == end) {
+                break;
+            }
+            skipping = false;
+            ++ptr;
+        }
+        output.flush();
+    }
+    return false;
+}
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Commands */////////////////////////////////////////////
+/**************************************************************************************************/
+
+bool lessPrecedence(const Entry & left, const Entry & right) {
+    return left.mVersion.comparePrecedence(right.mVersion) < 0;
+}
+
+// Stable sort, the parts are sorted in parallel and then merged.
+void sortEntries(std::vector<Entry> & entries, std::size_t threads) {
+    threads = std::max<std::size_t>(1, std::min(threads, entries.size() / 1024));
+    std::vector<std::size_t> bounds;
+    for (std::size_t i = 0; i <= threads; ++i) {
+        bounds.push_back(entries.size() * i / threads);
+    }
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([&entries, &bounds, i]() {
+            std::stable_sort(entries.begin() + bounds[i], entries.begin() + bounds[i + 1], lessPrecedence);
+        });
+    }
+    for (auto & w : workers) {
+        w.join();
+    }
+    while (bounds.size() > 2) {
+        std::vector<std::size_t> merged(1, 0);
+        for (std::size_t i = 2; i < bounds.size(); i += 2) {
+            std::inplace_merge(entries.begin() + bounds[i - 2], entries.begin() + bounds[i - 1],
+                               entries.begin() + bounds[i], lessPrecedence);
+            merged.push_back(bounds[i]);
+        }
+        if (merged.back() != bounds.back()) {
+            merged.push_back(bounds.back());
+        }
+        bounds.swap(merged);
+    }
+}
+
+int printUsage() {
+    std::fprintf(stderr,
+                 "%s v%s\n"
+                 "usage: %s [-j threads] <command> [file]\n"
+                 "commands:\n"
+                 "    sort            sort versions by the precedence (stable)\n"
+                 "    max             print the version with the highest precedence\n"
+                 "    min             print the version with the lowest precedence\n"
+                 "    filter <range>  print versions which satisfy the range, e.g. \">=1.2.0 <2.0.0 || ^3.1.0\"\n"
+                 "    validate        print invalid tokens, exit code is 1 if there are any\n"
+                 "    uniq            sort versions and print one version per precedence\n"
+                 "Versions are separated by whitespace, stdin is read if the file isn't specified.\n"
+                 "All the commands except sort and uniq process the input as it comes.\n",
+                 STS_SEMVER_PROJECT_ID, STS_SEMVER_VERSION_STRING, STS_SEMVER_PROJECT_ID "-tool");
+    return 2;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+int main(int argc, char ** argv) {
+    std::size_t threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    int arg = 1;
+    if (arg + 1 < argc && std::strcmp(argv[arg], "-j") == 0) {
+        threads = std::max<std::size_t>(1, std::strtoul(argv[arg + 1], nullptr, 10));
+        arg += 2;
+    }
+    if (arg >= argc) {
+        return printUsage();
+    }
+    const std::string command = argv[arg++];
+    Range range;
+    if (command == "filter") {
+        if (arg >= argc) {
+            return printUsage();
+        }
+        range = Range::parse(argv[arg++]);
+        if (!range) {
+            std::fprintf(stderr, "invalid range: %s\n", argv[arg - 1]);
+            return 2;
+        }
+    }
+    else if (command != "sort" && command != "max" && command != "min" &&
+             command != "validate" && command != "uniq") {
+        return printUsage();
+    }
+    if (arg + 1 < argc) {
+        return printUsage();
+    }
+    const char * path = arg < argc ? argv[arg] : nullptr;
+
+    Input input;
+    if (!input.open(path)) {
+        std::fprintf(stderr, "can't open the input: %s\n", path ? path : "stdin");
+        return 2;
+    }
+    Output output;
+    bool readOk = true;
+
+    if (command == "sort" || command == "uniq") {
+        // the only commands which need the whole input
+        std::vector<char> buffer;
+        readOk = input.readAll(buffer);
+        if (readOk) {
+            std::vector<Entry> entries = parse(buffer, threads);
+            sortEntries(entries, threads);
+            for (std::size_t i = 0; i < entries.size(); ++i) {
+                if (command == "sort" || i == 0 || lessPrecedence(entries[i - 1], entries[i])) {
+                    output.line(entries[i].mText, entries[i].mLength);
+                }
+            }
+        }
+    }
+    else if (command == "max" || command == "min") {
+        const bool max = command == "max";
+        SemVersion current;
+        SemVersion best;
+        std::string bestText;
+        bool found = false;
+        readOk = forEachToken(input, output, [&](const char * text, const std::size_t length) {
+            if (!SemVersion::parse(text, length, current)) {
+                return;
+            }
+            const int res = current.comparePrecedence(best);
+            if (!found || (max ? res > 0 : res < 0)) {
+                std::swap(current, best);
+                bestText.assign(text, length);
+                found = true;
+            }
+        });
+        if (readOk && found) {
+            output.line(bestText.data(), bestText.length());
+        }
+        else if (readOk) {
+            return 1;
+        }
+    }
+    else if (command == "filter") {
+        SemVersion version;
+        readOk = forEachToken(input, output, [&](const char * text, const std::size_t length) {
+            if (SemVersion::parse(text, length, version) && range.contains(version)) {
+                output.line(text, length);
+            }
+        });
+    }
+    else if (command == "validate") {
+        SemVersion version;
+        std::size_t valid = 0;
+        std::size_t invalid = 0;
+        readOk = forEachToken(input, output, [&](const char * text, const std::size_t length) {
+            if (SemVersion::parse(text, length, version)) {
+                ++valid;
+            }
+            else {
+                ++invalid;
+                output.line(text, length);
+            }
+        }, [&](const char * text, const std::size_t length) {
+            ++invalid;
+            const std::string line = std::string(text, length) + "...";
+            output.line(line.data(), line.length());
+        });
+        output.flush();
+        std::fprintf(stderr, "valid: %lu invalid: %lu\n",
+                     static_cast<unsigned long>(valid), static_cast<unsigned long>(invalid));
+        if (readOk) {
+            return invalid == 0 ? 0 : 1;
+        }
+    }
+    if (!readOk) {
+        output.flush();
+        std::fprintf(stderr, "can't read the input: %s\n", path ? path : "stdin");
+        return 2;
+    }
+    return 0;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
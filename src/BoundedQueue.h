@@ -0,0 +1,110 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+namespace sts {
+namespace semver {
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    /*
+     * Blocking queue with limited size,
+     * push waits while the queue is full so the producer can't run ahead of the consumers.
+     */
+    template<typename T>
+    class BoundedQueue {
+    public:
+
+        explicit BoundedQueue(const std::size_t capacity)
+            : mCapacity(capacity ? capacity : 1) {}
+
+        BoundedQueue(const BoundedQueue &) = delete;
+        BoundedQueue & operator=(const BoundedQueue &) = delete;
+
+        // Returns false if the queue is closed.
+        bool push(T value) {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mNotFull.wait(lock, [this] { return mClosed || mItems.size() < mCapacity; });
+            if (mClosed) {
+                return false;
+            }
+            mItems.emplace_back(std::move(value));
+            lock.unlock();
+            mNotEmpty.notify_one();
+            return true;
+        }
+
+        // Returns false if the queue is closed and empty.
+        bool pop(T & outValue) {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mNotEmpty.wait(lock, [this] { return mClosed || !mItems.empty(); });
+            if (mItems.empty()) {
+                return false;
+            }
+            outValue = std::move(mItems.front());
+            mItems.pop_front();
+            lock.unlock();
+            mNotFull.notify_one();
+            return true;
+        }
+
+        // The items which are already in the queue can still be popped.
+        void close() {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mClosed = true;
+            }
+            mNotEmpty.notify_all();
+            mNotFull.notify_all();
+        }
+
+    private:
+
+        std::mutex mMutex;
+        std::condition_variable mNotEmpty;
+        std::condition_variable mNotFull;
+        std::deque<T> mItems;
+        std::size_t mCapacity;
+        bool mClosed = false;
+
+    };
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+}
+}
@@ -0,0 +1,277 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include "sts/semver/CApi.h"
+#include "sts/semver/Range.h"
+#include "Scanner.h"
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Local *////////////////////////////////////////////////
+/**************************************************************************************************/
+
+struct sts_semver_range {
+    sts::semver::Range mRange;
+};
+
+namespace {
+
+    using sts::semver::Range;
+    using sts::semver::SemVersion;
+    namespace scanner = sts::semver::scanner;
+    using scanner::isDelimiter;
+
+    void parse(const char * str, const std::size_t length, sts_semver_version & outVersion) {
+        std::memset(&outVersion, 0, sizeof(outVersion));
+        scanner::Parts parts;
+        std::uint32_t numbers[3];
+        if (!scanner::parseParts(str, length, parts, numbers)) {
+            return;
+        }
+        outVersion.major = numbers[0];
+        outVersion.minor = numbers[1];
+        outVersion.patch = numbers[2];
+        if (parts.mPreRelease != parts.mPreReleaseEnd) {
+            outVersion.pre_release = parts.mPreRelease;
+            outVersion.pre_release_length = static_cast<std::uint32_t>(parts.mPreReleaseEnd - parts.mPreRelease);
+        }
+        if (parts.mBuild != parts.mBuildEnd) {
+            outVersion.build = parts.mBuild;
+            outVersion.build_length = static_cast<std::uint32_t>(parts.mBuildEnd - parts.mBuild);
+        }
+        outVersion.valid = 1;
+    }
+
+    int compare(const sts_semver_version & left, const sts_semver_version & right) {
+        if (!left.valid || !right.valid) {
+            return scanner::compareNumber(left.valid, right.valid);
+        }
+        const std::uint32_t leftNumbers[3] = {left.major, left.minor, left.patch};
+        const std::uint32_t rightNumbers[3] = {right.major, right.minor, right.patch};
+        return scanner::comparePrecedence(leftNumbers, left.pre_release, left.pre_release_length,
+                                          rightNumbers, right.pre_release, right.pre_release_length);
+    }
+
+    // The same as Range::contains but without creating SemVersion.
+    bool contains(const Range & range, const sts_semver_version & version) {
+        if (!version.valid) {
+            return false;
+        }
+        const std::uint32_t numbers[3] = {version.major, version.minor, version.patch};
+        return range.containsBy([&](const SemVersion & other) {
+            const std::uint32_t otherNumbers[3] = {other.mMajor, other.mMinor, other.mPatch};
+            return scanner::comparePrecedence(numbers, version.pre_release, version.pre_release_length,
+                                              otherNumbers, other.mPreRelease.data(), other.mPreRelease.length());
+        });
+    }
+
+    std::size_t numberLength(std::uint32_t value) {
+        std::size_t res = 1;
+        while (value >= 10) {
+            value /= 10;
+            ++res;
+        }
+        return res;
+    }
+
+    std::size_t formattedLength(const sts_semver_version & v, const bool preRelease, const bool build) {
+        if (!v.valid) {
+            return 0;
+        }
+        std::size_t res = numberLength(v.major) + numberLength(v.minor) + numberLength(v.patch) + 2;
+        if (preRelease && v.pre_release_length != 0) {
+            res += v.pre_release_length + 1;
+        }
+        if (build && v.build_length != 0) {
+            res += v.build_length + 1;
+        }
+        return res;
+    }
+
+    char * format(const sts_semver_version & v, const bool preRelease, const bool build, char * out) {
+        if (!v.valid) {
+            return out;
+        }
+        out = scanner::writeUint32(v.major, out);
+        *out++ = '.';
+        out = scanner::writeUint32(v.minor, out);
+        *out++ = '.';
+        out = scanner::writeUint32(v.patch, out);
+        if (preRelease && v.pre_release_length != 0) {
+            *out++ = '-';
+            std::memcpy(out, v.pre_release, v.pre_release_length);
+            out += v.pre_release_length;
+        }
+        if (build && v.build_length != 0) {
+            *out++ = '+';
+            std::memcpy(out, v.build, v.build_length);
+            out += v.build_length;
+        }
+        return out;
+    }
+
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+std::uint32_t sts_semver_api_version(void) {
+    return STS_SEMVER_C_API_VERSION;
+}
+
+std::size_t sts_semver_parse_n(const char * const * strings, const std::size_t * lengths, const std::size_t count,
+                               sts_semver_version * outVersions) {
+    std::size_t res = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const char * str = strings[i];
+        parse(str, lengths ? lengths[i] : (str ? std::strlen(str) : 0), outVersions[i]);
+        res += outVersions[i].valid;
+    }
+    return res;
+}
+
+std::size_t sts_semver_parse_buffer(const char * data, const std::size_t size,
+                                    sts_semver_version * outVersions, const std::size_t capacity) {
+    std::size_t res = 0;
+    const char * ptr = data;
+    const char * end = data + size;
+    while (ptr != end) {
+        if (isDelimiter(*ptr)) {
+            ++ptr;
+            continue;
+        }
+        const char * token = ptr;
+        while (ptr != end && !isDelimiter(*ptr)) {
+            ++ptr;
+        }
+        if (res < capacity) {
+            parse(token, static_cast<std::size_t>(ptr - token), outVersions[res]);
+        }
+        ++res;
+    }
+    return res;
+}
+
+int sts_semver_compare(const sts_semver_version * left, const sts_semver_version * right) {
+    return compare(*left, *right);
+}
+
+void sts_semver_compare_n(const sts_semver_version * left, const sts_semver_version * right, const std::size_t count,
+                          std::int8_t * outResults) {
+    for (std::size_t i = 0; i < count; ++i) {
+        outResults[i] = static_cast<std::int8_t>(compare(left[i], right[i]));
+    }
+}
+
+void sts_semver_sort(sts_semver_version * versions, const std::size_t count) {
+    // std::stable_sort falls back to the slower algorithm without throwing if it can't allocate the buffer
+    std::stable_sort(versions, versions + count, [](const sts_semver_version & l, const sts_semver_version & r) {
+        return compare(l, r) < 0;
+    });
+}
+
+void sts_semver_sort_indices(const sts_semver_version * versions, const std::size_t count, std::size_t * outIndices) {
+    for (std::size_t i = 0; i < count; ++i) {
+        outIndices[i] = i;
+    }
+    // the positions make the order stable without the temporary buffer of std::stable_sort
+    std::sort(outIndices, outIndices + count, [versions](const std::size_t l, const std::size_t r) {
+        const int res = compare(versions[l], versions[r]);
+        return res != 0 ? res < 0 : l < r;
+    });
+}
+
+std::size_t sts_semver_format_n(const sts_semver_version * versions, const std::size_t count,
+                                const int withPreRelease, const int withBuild, const char separator,
+                                char * outBuffer, const std::size_t capacity) {
+    std::size_t res = count != 0 ? count - 1 : 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        res += formattedLength(versions[i], withPreRelease != 0, withBuild != 0);
+    }
+    ++res;
+    if (res > capacity) {
+        return res;
+    }
+    char * out = outBuffer;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i != 0) {
+            *out++ = separator;
+        }
+        out = format(versions[i], withPreRelease != 0, withBuild != 0, out);
+    }
+    *out = '\0';
+    return res;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+sts_semver_range * sts_semver_range_parse(const char * range, const std::size_t length) {
+    try {
+        Range parsed = Range::parse(range, length);
+        if (!parsed) {
+            return nullptr;
+        }
+        sts_semver_range * res = new sts_semver_range;
+        res->mRange = std::move(parsed);
+        return res;
+    }
+    catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+}
+
+void sts_semver_range_free(sts_semver_range * range) {
+    delete range;
+}
+
+std::size_t sts_semver_range_match_n(const sts_semver_range * range, const sts_semver_version * versions,
+                                     const std::size_t count, std::uint8_t * outMask) {
+    std::memset(outMask, 0, (count + 7) / 8);
+    std::size_t res = 0;
+    if (!range) {
+        return res;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (contains(range->mRange, versions[i])) {
+            outMask[i / 8] = static_cast<std::uint8_t>(outMask[i / 8] | (1u << (i % 8)));
+            ++res;
+        }
+    }
+    return res;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
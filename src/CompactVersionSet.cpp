@@ -0,0 +1,372 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <algorithm>
+#include <functional>
+#include "sts/semver/CompactVersionSet.h"
+#include "Scanner.h"
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Local *////////////////////////////////////////////////
+/**************************************************************************************************/
+
+namespace {
+
+    void writeVarint(std::uint32_t value, std::vector<std::uint8_t> & outData) {
+        while (value >= 0x80) {
+            outData.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        outData.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    const std::uint8_t * readVarint(const std::uint8_t * data, std::uint32_t & outValue) {
+        std::uint32_t value = 0;
+        unsigned shift = 0;
+        for (;;) {
+            const std::uint8_t byte = *data++;
+            value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                break;
+            }
+            shift += 7;
+        }
+        outValue = value;
+        return data;
+    }
+
+    int comparePreReleaseStrings(const std::string & left, const std::string & right) {
+        return sts::semver::scanner::comparePreRelease(left.data(), left.length(), right.data(), right.length());
+    }
+
+    // Pre-releases are ordered by precedence, the strings with equal precedence (rc.1 and rc.01) by bytes.
+    bool lessPreRelease(const std::string & left, const std::string & right) {
+        const int res = comparePreReleaseStrings(left, right);
+        return res != 0 ? res < 0 : left < right;
+    }
+
+    // Index + 1 of the string in the sorted dictionary, 0 for the empty string.
+    template<typename Less>
+    std::uint32_t dictionaryId(const std::vector<std::string> & dictionary, const std::string & str, Less less) {
+        if (str.empty()) {
+            return 0;
+        }
+        const auto found = std::lower_bound(dictionary.begin(), dictionary.end(), str, less);
+        return static_cast<std::uint32_t>(found - dictionary.begin()) + 1;
+    }
+
+    template<typename T>
+    std::size_t vectorMemory(const std::vector<T> & vector) {
+        return vector.capacity() * sizeof(T);
+    }
+
+    std::size_t stringsMemory(const std::vector<std::string> & strings) {
+        std::size_t res = vectorMemory(strings);
+        for (auto & s : strings) {
+            // the short strings are stored inside the object
+            if (s.capacity() > std::string().capacity()) {
+                res += s.capacity() + 1;
+            }
+        }
+        return res;
+    }
+
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////* Constructors/Destructor *//////////////////////////////////
+/**************************************************************************************************/
+
+sts::semver::CompactVersionSet::CompactVersionSet(const std::vector<SemVersion> & versions, const std::size_t blockSize)
+    : mBlockSize(blockSize ? blockSize : 1) {
+    for (auto & v : versions) {
+        if (!v.mPreRelease.empty()) {
+            mPreReleases.push_back(v.mPreRelease);
+        }
+        if (!v.mBuild.empty()) {
+            mBuilds.push_back(v.mBuild);
+        }
+    }
+    std::sort(mPreReleases.begin(), mPreReleases.end(), lessPreRelease);
+    mPreReleases.erase(std::unique(mPreReleases.begin(), mPreReleases.end()), mPreReleases.end());
+    mPreReleases.shrink_to_fit();
+    std::sort(mBuilds.begin(), mBuilds.end());
+    mBuilds.erase(std::unique(mBuilds.begin(), mBuilds.end()), mBuilds.end());
+    mBuilds.shrink_to_fit();
+
+    std::vector<Key> keys;
+    keys.reserve(versions.size());
+    for (auto & v : versions) {
+        Key key;
+        key.mMajor = v.mMajor;
+        key.mMinor = v.mMinor;
+        key.mPatch = v.mPatch;
+        key.mPreRelease = dictionaryId(mPreReleases, v.mPreRelease, lessPreRelease);
+        key.mBuild = dictionaryId(mBuilds, v.mBuild, std::less<std::string>());
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end(), [](const Key & l, const Key & r) { return compareKeys(l, r) < 0; });
+    keys.erase(std::unique(keys.begin(), keys.end(), [](const Key & l, const Key & r) { return compareKeys(l, r) == 0; }),
+               keys.end());
+
+    mSize = keys.size();
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if (i % mBlockSize == 0) {
+            Block block;
+            block.mFirst = keys[i];
+            block.mOffset = mData.size();
+            mBlocks.push_back(block);
+        }
+        else {
+            encode(keys[i - 1], keys[i], mData);
+        }
+    }
+    mBlocks.shrink_to_fit();
+    mData.shrink_to_fit();
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+sts::semver::CompactVersionSet::Iterator sts::semver::CompactVersionSet::begin() const {
+    return mSize != 0 ? at(0) : end();
+}
+
+sts::semver::CompactVersionSet::Iterator sts::semver::CompactVersionSet::at(const std::size_t index) const {
+    const Block & block = mBlocks[index / mBlockSize];
+    Iterator res;
+    res.mSet = this;
+    res.mIndex = index - index % mBlockSize;
+    res.mData = mData.data() + block.mOffset;
+    res.mKey = block.mFirst;
+    while (res.mIndex != index) {
+        res.mData = decode(res.mData, res.mKey);
+        ++res.mIndex;
+    }
+    res.materialize();
+    return res;
+}
+
+bool sts::semver::CompactVersionSet::contains(const SemVersion & version) const {
+    Key key;
+    key.mMajor = version.mMajor;
+    key.mMinor = version.mMinor;
+    key.mPatch = version.mPatch;
+    key.mPreRelease = dictionaryId(mPreReleases, version.mPreRelease, lessPreRelease);
+    key.mBuild = dictionaryId(mBuilds, version.mBuild, std::less<std::string>());
+    if ((key.mPreRelease != 0 && (key.mPreRelease > mPreReleases.size() ||
+                                  mPreReleases[key.mPreRelease - 1] != version.mPreRelease)) ||
+        (key.mBuild != 0 && (key.mBuild > mBuilds.size() || mBuilds[key.mBuild - 1] != version.mBuild))) {
+        return false;
+    }
+    // the last block which starts not after the key
+    const auto block = std::upper_bound(mBlocks.begin(), mBlocks.end(), key,
+                                        [](const Key & k, const Block & b) { return compareKeys(k, b.mFirst) < 0; });
+    if (block == mBlocks.begin()) {
+        return false;
+    }
+    const std::size_t blockIndex = static_cast<std::size_t>(block - mBlocks.begin()) - 1;
+    const std::size_t count = std::min(mBlockSize, mSize - blockIndex * mBlockSize);
+    Key current = mBlocks[blockIndex].mFirst;
+    const std::uint8_t * data = mData.data() + mBlocks[blockIndex].mOffset;
+    for (std::size_t i = 0;; ++i) {
+        const int res = compareKeys(current, key);
+        if (res >= 0) {
+            return res == 0;
+        }
+        if (i + 1 == count) {
+            return false;
+        }
+        data = decode(data, current);
+    }
+}
+
+sts::semver::CompactVersionSet::Iterator sts::semver::CompactVersionSet::lowerBound(const SemVersion & version) const {
+    const PreReleaseRange preRelease = preReleaseRange(version.mPreRelease);
+    // the first block which starts not lower than the version
+    const auto block = std::lower_bound(mBlocks.begin(), mBlocks.end(), version,
+                                        [&](const Block & b, const SemVersion & v) {
+                                            return comparePrecedence(b.mFirst, v, preRelease) < 0;
+                                        });
+    if (block == mBlocks.begin()) {
+        return begin();
+    }
+    // the result is in the previous block or it is the first version of the found block
+    const std::size_t blockIndex = static_cast<std::size_t>(block - mBlocks.begin()) - 1;
+    const std::size_t blockEnd = std::min(mSize, (blockIndex + 1) * mBlockSize);
+    std::size_t index = blockIndex * mBlockSize;
+    Key current = mBlocks[blockIndex].mFirst;
+    const std::uint8_t * data = mData.data() + mBlocks[blockIndex].mOffset;
+    while (index != blockEnd && comparePrecedence(current, version, preRelease) < 0) {
+        if (++index != blockEnd) {
+            data = decode(data, current);
+        }
+    }
+    if (index == blockEnd) {
+        return index != mSize ? at(index) : end();
+    }
+    Iterator res;
+    res.mSet = this;
+    res.mIndex = index;
+    res.mData = data;
+    res.mKey = current;
+    res.materialize();
+    return res;
+}
+
+std::size_t sts::semver::CompactVersionSet::memoryUsage() const {
+    return sizeof(*this) + vectorMemory(mBlocks) + vectorMemory(mData) +
+           stringsMemory(mPreReleases) + stringsMemory(mBuilds);
+}
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Internal *////////////////////////////////////////////
+/**************************************************************************************************/
+
+int sts::semver::CompactVersionSet::compareKeys(const Key & left, const Key & right) {
+    if (left.mMajor != right.mMajor) {
+        return left.mMajor < right.mMajor ? -1 : 1;
+    }
+    if (left.mMinor != right.mMinor) {
+        return left.mMinor < right.mMinor ? -1 : 1;
+    }
+    if (left.mPatch != right.mPatch) {
+        return left.mPatch < right.mPatch ? -1 : 1;
+    }
+    // a version without pre-release has higher precedence
+    const std::uint32_t lPre = left.mPreRelease != 0 ? left.mPreRelease : UINT32_MAX;
+    const std::uint32_t rPre = right.mPreRelease != 0 ? right.mPreRelease : UINT32_MAX;
+    if (lPre != rPre) {
+        return lPre < rPre ? -1 : 1;
+    }
+    if (left.mBuild != right.mBuild) {
+        return left.mBuild < right.mBuild ? -1 : 1;
+    }
+    return 0;
+}
+
+int sts::semver::CompactVersionSet::comparePrecedence(const Key & key, const SemVersion & version,
+                                                      const PreReleaseRange & preRelease) {
+    if (key.mMajor != version.mMajor) {
+        return key.mMajor < version.mMajor ? -1 : 1;
+    }
+    if (key.mMinor != version.mMinor) {
+        return key.mMinor < version.mMinor ? -1 : 1;
+    }
+    if (key.mPatch != version.mPatch) {
+        return key.mPatch < version.mPatch ? -1 : 1;
+    }
+    if (key.mPreRelease == 0 || version.mPreRelease.empty()) {
+        return key.mPreRelease == 0 ? (version.mPreRelease.empty() ? 0 : 1) : -1;
+    }
+    if (key.mPreRelease < preRelease.mBegin) {
+        return -1;
+    }
+    return key.mPreRelease < preRelease.mEnd ? 0 : 1;
+}
+
+sts::semver::CompactVersionSet::PreReleaseRange
+sts::semver::CompactVersionSet::preReleaseRange(const std::string & preRelease) const {
+    const auto range = std::equal_range(mPreReleases.begin(), mPreReleases.end(), preRelease,
+                                        [](const std::string & l, const std::string & r) {
+                                            return comparePreReleaseStrings(l, r) < 0;
+                                        });
+    PreReleaseRange res;
+    res.mBegin = static_cast<std::uint32_t>(range.first - mPreReleases.begin()) + 1;
+    res.mEnd = static_cast<std::uint32_t>(range.second - mPreReleases.begin()) + 1;
+    return res;
+}
+
+const std::uint8_t * sts::semver::CompactVersionSet::decode(const std::uint8_t * data, Key & inOutKey) {
+    std::uint32_t major = 0;
+    std::uint32_t minor = 0;
+    std::uint32_t patch = 0;
+    data = readVarint(data, major);
+    data = readVarint(data, minor);
+    data = readVarint(data, patch);
+    if (major != 0) {
+        inOutKey.mMajor += major;
+        inOutKey.mMinor = minor;
+        inOutKey.mPatch = patch;
+    }
+    else if (minor != 0) {
+        inOutKey.mMinor += minor;
+        inOutKey.mPatch = patch;
+    }
+    else {
+        inOutKey.mPatch += patch;
+    }
+    data = readVarint(data, inOutKey.mPreRelease);
+    return readVarint(data, inOutKey.mBuild);
+}
+
+void sts::semver::CompactVersionSet::encode(const Key & previous, const Key & key, std::vector<std::uint8_t> & outData) {
+    const std::uint32_t major = key.mMajor - previous.mMajor;
+    const std::uint32_t minor = major != 0 ? key.mMinor : key.mMinor - previous.mMinor;
+    const std::uint32_t patch = major != 0 || minor != 0 ? key.mPatch : key.mPatch - previous.mPatch;
+    writeVarint(major, outData);
+    writeVarint(minor, outData);
+    writeVarint(patch, outData);
+    writeVarint(key.mPreRelease, outData);
+    writeVarint(key.mBuild, outData);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////* Iterator *////////////////////////////////////////////////
+/**************************************************************************************************/
+
+sts::semver::CompactVersionSet::Iterator & sts::semver::CompactVersionSet::Iterator::operator++() {
+    ++mIndex;
+    if (mIndex == mSet->mSize) {
+        return *this;
+    }
+    if (mIndex % mSet->mBlockSize == 0) {
+        const Block & block = mSet->mBlocks[mIndex / mSet->mBlockSize];
+        mKey = block.mFirst;
+        mData = mSet->mData.data() + block.mOffset;
+    }
+    else {
+        mData = decode(mData, mKey);
+    }
+    materialize();
+    return *this;
+}
+
+void sts::semver::CompactVersionSet::Iterator::materialize() {
+    const std::string * preRelease = mKey.mPreRelease != 0 ? &mSet->mPreReleases[mKey.mPreRelease - 1] : nullptr;
+    const std::string * build = mKey.mBuild != 0 ? &mSet->mBuilds[mKey.mBuild - 1] : nullptr;
+    mVersion.set(mKey.mMajor, mKey.mMinor, mKey.mPatch,
+                 preRelease ? preRelease->data() : nullptr, preRelease ? preRelease->length() : 0,
+                 build ? build->data() : nullptr, build ? build->length() : 0);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,181 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include "sts/semver/PreReleaseIndex.h"
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Local *////////////////////////////////////////////////
+/**************************************************************************************************/
+
+namespace {
+
+    // Calls the function for each dot-separated identifier of the pre-release.
+    template<typename Function>
+    void forEachIdentifier(const std::string & preRelease, Function function) {
+        if (preRelease.empty()) {
+            return;
+        }
+        const char * ptr = preRelease.data();
+        const char * end = ptr + preRelease.length();
+        for (std::uint32_t position = 0;; ++position) {
+            const char * dot = std::find(ptr, end, '.');
+            function(ptr, static_cast<std::size_t>(dot - ptr), position);
+            if (dot == end) {
+                break;
+            }
+            ptr = dot + 1;
+        }
+    }
+
+    int compareBytes(const char * left, const std::size_t leftLength, const char * right, const std::size_t rightLength) {
+        const int res = std::memcmp(left, right, std::min(leftLength, rightLength));
+        if (res != 0) {
+            return res;
+        }
+        return leftLength == rightLength ? 0 : (leftLength < rightLength ? -1 : 1);
+    }
+
+    struct Token {
+        const char * mPtr;
+        std::size_t mLength;
+        std::uint32_t mVersion;
+        std::uint32_t mPosition;
+    };
+
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////* Constructors/Destructor *//////////////////////////////////
+/**************************************************************************************************/
+
+sts::semver::PreReleaseIndex::PreReleaseIndex(const std::vector<SemVersion> & versions)
+    : mVersions(versions) {
+    std::vector<Token> tokens;
+    for (std::size_t i = 0; i < mVersions.size(); ++i) {
+        forEachIdentifier(mVersions[i].mPreRelease, [&](const char * ptr, const std::size_t length, const std::uint32_t position) {
+            tokens.push_back(Token{ptr, length, static_cast<std::uint32_t>(i), position});
+        });
+    }
+    std::sort(tokens.begin(), tokens.end(), [](const Token & l, const Token & r) {
+        const int res = compareBytes(l.mPtr, l.mLength, r.mPtr, r.mLength);
+        if (res != 0) {
+            return res < 0;
+        }
+        return l.mVersion != r.mVersion ? l.mVersion < r.mVersion : l.mPosition < r.mPosition;
+    });
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        const Token & t = tokens[i];
+        if (i == 0 || compareBytes(tokens[i - 1].mPtr, tokens[i - 1].mLength, t.mPtr, t.mLength) != 0) {
+            mDictionary.emplace_back();
+            mDictionary.back().mIdentifier.assign(t.mPtr, t.mLength);
+        }
+        mDictionary.back().mPostings.push_back(Posting{t.mVersion, t.mPosition});
+    }
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+std::size_t sts::semver::PreReleaseIndex::insert(const SemVersion & version) {
+    const std::uint32_t id = static_cast<std::uint32_t>(mVersions.size());
+    mVersions.push_back(version);
+    forEachIdentifier(mVersions.back().mPreRelease, [&](const char * ptr, const std::size_t length, const std::uint32_t position) {
+        auto entry = std::lower_bound(mDictionary.begin(), mDictionary.end(), std::make_pair(ptr, length),
+                                      [](const Entry & e, const std::pair<const char *, std::size_t> & identifier) {
+                                          return compareBytes(e.mIdentifier.data(), e.mIdentifier.length(),
+                                                              identifier.first, identifier.second) < 0;
+                                      });
+        if (entry == mDictionary.end() || entry->mIdentifier.compare(0, std::string::npos, ptr, length) != 0) {
+            entry = mDictionary.emplace(entry);
+            entry->mIdentifier.assign(ptr, length);
+        }
+        // the new version has the highest position so the postings stay ordered
+        entry->mPostings.push_back(Posting{id, position});
+    });
+    return id;
+}
+
+std::vector<std::size_t> sts::semver::PreReleaseIndex::find(const Query & query) const {
+    const std::string & identifier = query.mIdentifier;
+    auto begin = std::lower_bound(mDictionary.begin(), mDictionary.end(), identifier,
+                                  [](const Entry & e, const std::string & str) { return e.mIdentifier < str; });
+    auto end = begin;
+    if (query.mPrefix) {
+        while (end != mDictionary.end() && end->mIdentifier.compare(0, identifier.length(), identifier) == 0) {
+            ++end;
+        }
+    }
+    else if (end != mDictionary.end() && end->mIdentifier == identifier) {
+        ++end;
+    }
+
+    std::vector<std::size_t> res;
+    for (auto entry = begin; entry != end; ++entry) {
+        for (auto & p : entry->mPostings) {
+            if (p.mPosition != query.mPosition) {
+                continue;
+            }
+            const SemVersion & v = mVersions[p.mVersion];
+            if (query.mMajor.contains(v.mMajor) && query.mMinor.contains(v.mMinor) && query.mPatch.contains(v.mPatch)) {
+                res.push_back(p.mVersion);
+            }
+        }
+    }
+    // a version has only one identifier at the position so the lists of the entries don't intersect
+    if (end - begin > 1) {
+        std::sort(res.begin(), res.end());
+    }
+    return res;
+}
+
+std::vector<std::size_t> sts::semver::PreReleaseIndex::latestPerMinor(const Query & query) const {
+    std::map<std::pair<std::uint32_t, std::uint32_t>, std::size_t> latest;
+    for (auto id : find(query)) {
+        const SemVersion & v = mVersions[id];
+        const auto inserted = latest.emplace(std::make_pair(v.mMajor, v.mMinor), id);
+        if (!inserted.second && v.comparePrecedence(mVersions[inserted.first->second]) > 0) {
+            inserted.first->second = id;
+        }
+    }
+    std::vector<std::size_t> res;
+    res.reserve(latest.size());
+    for (auto & l : latest) {
+        res.push_back(l.second);
+    }
+    return res;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,182 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstdint>
+#include "sts/semver/Range.h"
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Local *////////////////////////////////////////////////
+/**************************************************************************************************/
+
+namespace {
+
+    using sts::semver::Range;
+    using sts::semver::SemVersion;
+
+    bool isSpace(const char ch) {
+        return ch == ' ' || ch == '\t';
+    }
+
+    const char * skipSpaces(const char * ptr, const char * end) {
+        while (ptr != end && isSpace(*ptr)) {
+            ++ptr;
+        }
+        return ptr;
+    }
+
+    Range::Comparator makeComparator(const Range::Operation operation, const SemVersion & version) {
+        Range::Comparator res;
+        res.mOperation = operation;
+        res.mVersion = version;
+        return res;
+    }
+
+    // Adds '^' or '~' comparators.
+    // The upper bound is the first pre-release after the numbers down to the level (0 - major, 1 - minor, 2 - patch).
+    // A number at UINT32_MAX is carried to the higher one, if there is no higher one then the range has no upper bound.
+    void addCaretTilde(const char op, const SemVersion & version, Range::ComparatorSet & outSet) {
+        outSet.emplace_back(makeComparator(Range::Operation::GreaterOrEqual, version));
+        int level = 2;
+        if (op == '~' || (version.mMajor == 0 && version.mMinor != 0)) {
+            level = 1;
+        }
+        else if (version.mMajor != 0) {
+            level = 0;
+        }
+        std::uint32_t numbers[3] = {version.mMajor, version.mMinor, version.mPatch};
+        while (level >= 0 && numbers[level] == UINT32_MAX) {
+            --level;
+        }
+        if (level < 0) {
+            return;
+        }
+        ++numbers[level];
+        for (int i = level + 1; i < 3; ++i) {
+            numbers[i] = 0;
+        }
+        outSet.emplace_back(makeComparator(Range::Operation::Less, SemVersion(numbers[0], numbers[1], numbers[2], "0", "")));
+    }
+
+    bool parseSet(const char * ptr, const char * end, Range::ComparatorSet & outSet) {
+        ptr = skipSpaces(ptr, end);
+        if (ptr != end && *ptr == '*' && skipSpaces(ptr + 1, end) == end) {
+            return true;
+        }
+        while (ptr != end) {
+            const char * opBegin = ptr;
+            while (ptr != end && (*ptr == '<' || *ptr == '>' || *ptr == '=' || *ptr == '^' || *ptr == '~')) {
+                ++ptr;
+            }
+            const std::size_t opLength = static_cast<std::size_t>(ptr - opBegin);
+            ptr = skipSpaces(ptr, end);
+            const char * versionBegin = ptr;
+            while (ptr != end && !isSpace(*ptr)) {
+                ++ptr;
+            }
+            SemVersion version;
+            if (!SemVersion::parse(versionBegin, static_cast<std::size_t>(ptr - versionBegin), version)) {
+                return false;
+            }
+            ptr = skipSpaces(ptr, end);
+
+            const char op0 = opLength > 0 ? opBegin[0] : '\0';
+            const char op1 = opLength > 1 ? opBegin[1] : '\0';
+            if (opLength > 2 || (opLength == 2 && (op1 != '=' || (op0 != '<' && op0 != '>')))) {
+                return false;
+            }
+            if (op0 == '^' || op0 == '~') {
+                addCaretTilde(op0, version, outSet);
+                continue;
+            }
+            Range::Operation operation = Range::Operation::Equal;
+            if (op0 == '<') {
+                operation = op1 == '=' ? Range::Operation::LessOrEqual : Range::Operation::Less;
+            }
+            else if (op0 == '>') {
+                operation = op1 == '=' ? Range::Operation::GreaterOrEqual : Range::Operation::Greater;
+            }
+            outSet.emplace_back(makeComparator(operation, version));
+        }
+        return true;
+    }
+
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+bool sts::semver::Range::Comparator::test(const SemVersion & version) const STS_SEMVER_NOEXCEPT {
+    return testPrecedence(version.comparePrecedence(mVersion));
+}
+
+bool sts::semver::Range::Comparator::testPrecedence(const int precedence) const STS_SEMVER_NOEXCEPT {
+    switch (mOperation) {
+        case Operation::Equal: return precedence == 0;
+        case Operation::Less: return precedence < 0;
+        case Operation::LessOrEqual: return precedence <= 0;
+        case Operation::Greater: return precedence > 0;
+        case Operation::GreaterOrEqual: return precedence >= 0;
+    }
+    return false;
+}
+
+bool sts::semver::Range::contains(const SemVersion & version) const STS_SEMVER_NOEXCEPT {
+    return containsBy([&version](const SemVersion & other) {
+        return version.comparePrecedence(other);
+    });
+}
+
+sts::semver::Range sts::semver::Range::parse(const char * range, const std::size_t length) {
+    Range res;
+    if (!range) {
+        return res;
+    }
+    const char * ptr = range;
+    const char * end = range + length;
+    for (;;) {
+        const char * setEnd = ptr;
+        while (setEnd != end && !(*setEnd == '|' && setEnd + 1 != end && setEnd[1] == '|')) {
+            ++setEnd;
+        }
+        res.mSets.emplace_back();
+        if (!parseSet(ptr, setEnd, res.mSets.back())) {
+            return Range();
+        }
+        if (setEnd == end) {
+            break;
+        }
+        ptr = setEnd + 2;
+    }
+    return res;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
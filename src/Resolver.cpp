@@ -0,0 +1,792 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include "sts/semver/Resolver.h"
+#include "sts/semver/Range.h"
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Local *////////////////////////////////////////////////
+/**************************************************************************************************/
+
+namespace {
+
+    using sts::semver::Dependency;
+    using sts::semver::Provider;
+    using sts::semver::Range;
+    using sts::semver::Resolver;
+    using sts::semver::SemVersion;
+
+    const std::uint32_t gRoot = UINT32_MAX;
+    const std::uint32_t gNone = UINT32_MAX;
+    // The cache of the intersections is cleared when it gets bigger.
+    const std::size_t gMaxIntersections = 4096;
+
+    // Identifies a dependency independently of the solver instance: source, its version, target and range.
+    typedef std::string EdgeKey;
+    typedef std::set<EdgeKey> EdgeKeys;
+
+    EdgeKey makeEdgeKey(const std::string & source, const std::string & sourceVersion,
+                        const std::string & target, const std::string & range) {
+        return source + '\n' + sourceVersion + '\n' + target + '\n' + range;
+    }
+
+    // One bit per package version.
+    typedef std::vector<std::uint64_t> Bitset;
+
+    bool testBit(const Bitset & bits, const std::uint32_t index) {
+        return (bits[index / 64] >> (index % 64)) & 1;
+    }
+
+    void setBit(Bitset & bits, const std::uint32_t index) {
+        bits[index / 64] |= std::uint64_t(1) << (index % 64);
+    }
+
+    struct Package {
+        std::string mName;
+        // Newest first.
+        std::vector<SemVersion> mVersions;
+        // Edges of each version, they are loaded when the package is decided first time.
+        std::vector<std::vector<std::uint32_t>> mEdges;
+        bool mEdgesLoaded = false;
+        // Versions with the same dependencies as the version,
+        // they constrain the other packages in the same way.
+        std::vector<Bitset> mSameEdges;
+        // Edges which constrain this package now.
+        std::vector<std::uint32_t> mActive;
+        // Nogoods which have this package.
+        std::vector<std::uint32_t> mNogoods;
+        // Assigned version index or -1.
+        std::int64_t mAssigned = -1;
+        // Index of the decision if assigned.
+        std::size_t mLevel = 0;
+    };
+
+    // Range of a package, it is shared by all the edges which require the same range.
+    struct Constraint {
+        std::uint32_t mTarget;
+        std::string mRangeText;
+        Range mRange;
+        // Allowed target versions, it is computed lazily.
+        Bitset mAllowed;
+        bool mComputed = false;
+    };
+
+    // Dependency of a package version (or of the root) on a package.
+    struct Edge {
+        std::uint32_t mSource;
+        std::uint32_t mSourceVersion;
+        std::uint32_t mTarget;
+        std::uint32_t mConstraint;
+    };
+
+    enum class RejectionType {
+        // The dependency isn't satisfied by the already selected version.
+        Assigned,
+        // The dependency conflicts with the other constraints of the not selected yet package.
+        Constraints,
+        // The version is a part of a nogood.
+        Nogood,
+        // The dependency refers to itself with a range which doesn't contain the version.
+        Self,
+    };
+
+    struct Rejection {
+        std::uint32_t mVersion;
+        RejectionType mType;
+        // Edge or nogood index.
+        std::uint32_t mIndex;
+        // The other constraints of the target for RejectionType::Constraints.
+        std::vector<std::uint32_t> mOthers;
+    };
+
+    // The package has a version from the set.
+    struct Term {
+        std::uint32_t mPackage;
+        // The version which was assigned when the term was created.
+        std::uint32_t mVersion;
+        Bitset mVersions;
+    };
+
+    // Package -> versions, the conflict happens when all the packages have a version from its set.
+    typedef std::map<std::uint32_t, Bitset> Conflict;
+
+    // Combination of package versions which can't be in a solution.
+    struct Nogood {
+        std::vector<Term> mTerms;
+        // Why it was learned: the package which couldn't get a version.
+        std::uint32_t mPackage;
+        std::vector<std::uint32_t> mActive;
+        bool mNoCandidates;
+        std::vector<Rejection> mRejections;
+    };
+
+    struct Decision {
+        std::uint32_t mPackage;
+        std::vector<std::uint32_t> mCandidates;
+        std::size_t mNext = 0;
+        // Decisions which caused rejection of the candidates.
+        Conflict mConflict;
+        std::vector<Rejection> mRejections;
+    };
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    class Solver {
+    public:
+
+        /*
+         * The dependencies which aren't in the enabled set are ignored,
+         * it is used for looking for the minimal conflict.
+         */
+        explicit Solver(Provider & provider, const EdgeKeys * enabled = nullptr)
+            : mProvider(provider),
+              mEnabled(enabled) {}
+
+        // Returns false if the requirements can't be satisfied.
+        bool run(const std::vector<Dependency> & requirements) {
+            for (auto & r : requirements) {
+                const std::uint32_t edge = addEdge(gRoot, 0, r);
+                if (edge != gNone) {
+                    mPackages[mEdges[edge].mTarget].mActive.push_back(edge);
+                }
+            }
+            for (;;) {
+                const std::uint32_t next = nextPackage();
+                if (next == gRoot) {
+                    return true;
+                }
+                pushDecision(next);
+                if (!tryCandidates()) {
+                    return false;
+                }
+            }
+        }
+
+        void selected(std::map<std::string, SemVersion> & outVersions) const {
+            for (auto & p : mPackages) {
+                if (p.mAssigned != -1) {
+                    outVersions[p.mName] = p.mVersions[static_cast<std::size_t>(p.mAssigned)];
+                }
+            }
+        }
+
+        std::size_t attempts() const {
+            return mAttempts;
+        }
+
+        // The dependencies which the failed run has used for proving the conflict.
+        EdgeKeys conflictEdges() const {
+            EdgeKeys res;
+            std::vector<bool> visited(mNogoods.size(), false);
+            const Decision & d = mDecisions.back();
+            collectEdges(mPackages[d.mPackage].mActive, d.mRejections, visited, res);
+            return res;
+        }
+
+        // Explanation of the failed run.
+        std::vector<std::string> explain() const {
+            std::vector<std::string> res;
+            std::vector<bool> explained(mNogoods.size(), false);
+            const Decision & d = mDecisions.back();
+            explain(d.mPackage, mPackages[d.mPackage].mActive, d.mCandidates.empty(), d.mRejections, "", explained, res);
+            return res;
+        }
+
+    private:
+
+        //-------------------------------------------------------------------------
+
+        std::uint32_t package(const std::string & name) {
+            const auto found = mIndices.find(name);
+            if (found != mIndices.end()) {
+                return found->second;
+            }
+            const std::uint32_t index = static_cast<std::uint32_t>(mPackages.size());
+            mIndices.emplace(name, index);
+            mPackages.emplace_back();
+            Package & p = mPackages.back();
+            p.mName = name;
+            p.mVersions = mProvider.versions(name);
+            std::sort(p.mVersions.begin(), p.mVersions.end(), [](const SemVersion & l, const SemVersion & r) {
+                return l.comparePrecedence(r) > 0;
+            });
+            return index;
+        }
+
+        // Returns gNone if the dependency isn't enabled.
+        std::uint32_t addEdge(const std::uint32_t source, const std::uint32_t sourceVersion, const Dependency & dependency) {
+            if (mEnabled) {
+                const EdgeKey key = source == gRoot
+                                        ? makeEdgeKey("", "", dependency.mPackage, dependency.mRange)
+                                        : makeEdgeKey(mPackages[source].mName,
+                                                      mPackages[source].mVersions[sourceVersion].toString(true, true),
+                                                      dependency.mPackage, dependency.mRange);
+                if (mEnabled->find(key) == mEnabled->end()) {
+                    return gNone;
+                }
+            }
+            const std::uint32_t target = package(dependency.mPackage);
+            const auto inserted = mConstraintIndices.emplace(std::make_pair(target, dependency.mRange),
+                                                             static_cast<std::uint32_t>(mConstraints.size()));
+            if (inserted.second) {
+                mConstraints.emplace_back();
+                Constraint & c = mConstraints.back();
+                c.mTarget = target;
+                c.mRangeText = dependency.mRange;
+                c.mRange = Range::parse(dependency.mRange);
+            }
+            Edge e;
+            e.mSource = source;
+            e.mSourceVersion = sourceVersion;
+            e.mTarget = target;
+            e.mConstraint = inserted.first->second;
+            mEdges.push_back(e);
+            return static_cast<std::uint32_t>(mEdges.size() - 1);
+        }
+
+        EdgeKey edgeKey(const std::uint32_t edge) const {
+            const Edge & e = mEdges[edge];
+            if (e.mSource == gRoot) {
+                return makeEdgeKey("", "", mPackages[e.mTarget].mName, rangeText(edge));
+            }
+            return makeEdgeKey(mPackages[e.mSource].mName, mPackages[e.mSource].mVersions[e.mSourceVersion].toString(true, true),
+                               mPackages[e.mTarget].mName, rangeText(edge));
+        }
+
+        const std::string & rangeText(const std::uint32_t edge) const {
+            return mConstraints[mEdges[edge].mConstraint].mRangeText;
+        }
+
+        void loadEdges(const std::uint32_t pkg) {
+            if (mPackages[pkg].mEdgesLoaded) {
+                return;
+            }
+            const std::string name = mPackages[pkg].mName;
+            const std::vector<SemVersion> versions = mPackages[pkg].mVersions;
+            std::vector<std::vector<std::uint32_t>> allEdges;
+            std::map<std::vector<std::pair<std::string, std::string>>, Bitset> groups;
+            std::vector<Bitset *> versionGroups;
+            for (std::uint32_t v = 0; v < versions.size(); ++v) {
+                std::vector<std::uint32_t> res;
+                std::vector<std::pair<std::string, std::string>> key;
+                for (auto & d : mProvider.dependencies(name, versions[v])) {
+                    const std::uint32_t edge = addEdge(pkg, v, d);
+                    if (edge != gNone) {
+                        res.push_back(edge);
+                        key.emplace_back(d.mPackage, d.mRange);
+                    }
+                }
+                std::sort(key.begin(), key.end());
+                Bitset & group = groups[key];
+                group.resize((versions.size() + 63) / 64, 0);
+                setBit(group, v);
+                versionGroups.push_back(&group);
+                allEdges.emplace_back(std::move(res));
+            }
+            // mPackages may be reallocated by addEdge
+            Package & p = mPackages[pkg];
+            p.mEdges = std::move(allEdges);
+            for (auto g : versionGroups) {
+                p.mSameEdges.push_back(*g);
+            }
+            p.mEdgesLoaded = true;
+        }
+
+        const Bitset & allowedByConstraint(const std::uint32_t constraint) {
+            Constraint & c = mConstraints[constraint];
+            if (!c.mComputed) {
+                const Package & p = mPackages[c.mTarget];
+                c.mAllowed.assign((p.mVersions.size() + 63) / 64, 0);
+                for (std::size_t i = 0; i < p.mVersions.size(); ++i) {
+                    if (c.mRange.contains(p.mVersions[i])) {
+                        c.mAllowed[i / 64] |= std::uint64_t(1) << (i % 64);
+                    }
+                }
+                c.mComputed = true;
+            }
+            return c.mAllowed;
+        }
+
+        const Bitset & allowed(const std::uint32_t edge) {
+            return allowedByConstraint(mEdges[edge].mConstraint);
+        }
+
+        // Memoized intersection of the edges, they all must have the same target.
+        // The edges from different sources with the same range share the cache entries.
+        const Bitset & intersection(const std::vector<std::uint32_t> & edges) {
+            std::vector<std::uint32_t> key;
+            key.reserve(edges.size());
+            for (auto e : edges) {
+                key.push_back(mEdges[e].mConstraint);
+            }
+            std::sort(key.begin(), key.end());
+            key.erase(std::unique(key.begin(), key.end()), key.end());
+            const auto found = mIntersections.find(key);
+            if (found != mIntersections.end()) {
+                return found->second;
+            }
+            Bitset bits = allowedByConstraint(key[0]);
+            for (std::size_t i = 1; i < key.size(); ++i) {
+                const Bitset & other = allowedByConstraint(key[i]);
+                for (std::size_t w = 0; w < bits.size(); ++w) {
+                    bits[w] &= other[w];
+                }
+            }
+            if (mIntersections.size() >= gMaxIntersections) {
+                // the callers don't keep the references between the calls
+                mIntersections.clear();
+            }
+            return mIntersections.emplace(std::move(key), std::move(bits)).first->second;
+        }
+
+        static bool isEmpty(const Bitset & bits) {
+            for (auto w : bits) {
+                if (w != 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        //-------------------------------------------------------------------------
+
+        static std::size_t count(const Bitset & bits) {
+            std::size_t res = 0;
+            for (auto w : bits) {
+                for (; w != 0; w &= w - 1) {
+                    ++res;
+                }
+            }
+            return res;
+        }
+
+        // The not assigned package with constraints which has the fewest candidates,
+        // so the dead ends are found as early as possible.
+        std::uint32_t nextPackage() {
+            std::uint32_t res = gRoot;
+            std::size_t best = SIZE_MAX;
+            for (std::size_t i = 0; i < mPackages.size() && best != 0; ++i) {
+                if (mPackages[i].mAssigned == -1 && !mPackages[i].mActive.empty()) {
+                    const std::size_t candidates = count(intersection(mPackages[i].mActive));
+                    if (candidates < best) {
+                        best = candidates;
+                        res = static_cast<std::uint32_t>(i);
+                    }
+                }
+            }
+            return res;
+        }
+
+        static void addCondition(const std::uint32_t pkg, const Bitset & versions, Conflict & outConflict) {
+            const auto found = outConflict.find(pkg);
+            if (found == outConflict.end()) {
+                outConflict.emplace(pkg, versions);
+                return;
+            }
+            for (std::size_t w = 0; w < versions.size(); ++w) {
+                found->second[w] &= versions[w];
+            }
+        }
+
+        // Any version of the source with the same dependencies gives the same constraints.
+        void addSources(const std::vector<std::uint32_t> & edges, Conflict & outConflict) const {
+            for (auto e : edges) {
+                const Edge & edge = mEdges[e];
+                if (edge.mSource != gRoot) {
+                    addCondition(edge.mSource, mPackages[edge.mSource].mSameEdges[edge.mSourceVersion], outConflict);
+                }
+            }
+        }
+
+        void pushDecision(const std::uint32_t pkg) {
+            mDecisions.emplace_back();
+            Decision & d = mDecisions.back();
+            d.mPackage = pkg;
+            loadEdges(pkg);
+            const Bitset & bits = intersection(mPackages[pkg].mActive);
+            for (std::uint32_t i = 0; i < mPackages[pkg].mVersions.size(); ++i) {
+                if (testBit(bits, i)) {
+                    d.mCandidates.push_back(i);
+                }
+            }
+            // The package is required and constrained by these decisions.
+            addSources(mPackages[pkg].mActive, d.mConflict);
+        }
+
+        // Returns false if the requirements can't be satisfied.
+        bool tryCandidates() {
+            for (;;) {
+                Decision & d = mDecisions.back();
+                while (d.mNext < d.mCandidates.size()) {
+                    const std::uint32_t version = d.mCandidates[d.mNext++];
+                    ++mAttempts;
+                    if (check(d, version)) {
+                        assign(d.mPackage, version);
+                        return true;
+                    }
+                }
+                if (!backjump()) {
+                    return false;
+                }
+            }
+        }
+
+        bool check(Decision & d, const std::uint32_t version) {
+            const std::uint32_t pkg = d.mPackage;
+            for (auto n : mPackages[pkg].mNogoods) {
+                if (isNogoodHit(n, pkg, version)) {
+                    for (auto & t : mNogoods[n].mTerms) {
+                        if (t.mPackage != pkg) {
+                            addCondition(t.mPackage, t.mVersions, d.mConflict);
+                        }
+                    }
+                    d.mRejections.push_back(Rejection{version, RejectionType::Nogood, n, {}});
+                    return false;
+                }
+            }
+            for (auto e : mPackages[pkg].mEdges[version]) {
+                const std::uint32_t target = mEdges[e].mTarget;
+                const Package & t = mPackages[target];
+                if (target == pkg) {
+                    if (!testBit(allowed(e), version)) {
+                        d.mRejections.push_back(Rejection{version, RejectionType::Self, e, {}});
+                        return false;
+                    }
+                    continue;
+                }
+                if (t.mAssigned != -1) {
+                    const Bitset & bits = allowed(e);
+                    if (!testBit(bits, static_cast<std::uint32_t>(t.mAssigned))) {
+                        // Any version which isn't allowed by the dependency gives the same conflict.
+                        Bitset rejected(bits.size(), 0);
+                        for (std::uint32_t i = 0; i < t.mVersions.size(); ++i) {
+                            if (!testBit(bits, i)) {
+                                setBit(rejected, i);
+                            }
+                        }
+                        addCondition(target, rejected, d.mConflict);
+                        d.mRejections.push_back(Rejection{version, RejectionType::Assigned, e, {}});
+                        return false;
+                    }
+                    continue;
+                }
+                std::vector<std::uint32_t> constraints = t.mActive;
+                constraints.push_back(e);
+                if (isEmpty(intersection(constraints))) {
+                    addSources(t.mActive, d.mConflict);
+                    d.mRejections.push_back(Rejection{version, RejectionType::Constraints, e, t.mActive});
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool isNogoodHit(const std::uint32_t nogood, const std::uint32_t pkg, const std::uint32_t version) const {
+            for (auto & t : mNogoods[nogood].mTerms) {
+                if (t.mPackage == pkg) {
+                    if (!testBit(t.mVersions, version)) {
+                        return false;
+                    }
+                }
+                else {
+                    const std::int64_t assigned = mPackages[t.mPackage].mAssigned;
+                    if (assigned == -1 || !testBit(t.mVersions, static_cast<std::uint32_t>(assigned))) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        void assign(const std::uint32_t pkg, const std::uint32_t version) {
+            mPackages[pkg].mAssigned = version;
+            mPackages[pkg].mLevel = mDecisions.size() - 1;
+            for (auto e : mPackages[pkg].mEdges[version]) {
+                mPackages[mEdges[e].mTarget].mActive.push_back(e);
+            }
+        }
+
+        void unassign(const std::uint32_t pkg) {
+            Package & p = mPackages[pkg];
+            if (p.mAssigned == -1) {
+                return;
+            }
+            const auto & edges = p.mEdges[static_cast<std::size_t>(p.mAssigned)];
+            for (auto e = edges.rbegin(); e != edges.rend(); ++e) {
+                mPackages[mEdges[*e].mTarget].mActive.pop_back();
+            }
+            p.mAssigned = -1;
+        }
+
+        // The top decision has no more candidates.
+        bool backjump() {
+            Decision & failed = mDecisions.back();
+            Conflict conflict = std::move(failed.mConflict);
+            conflict.erase(failed.mPackage);
+            if (conflict.empty()) {
+                return false;
+            }
+            // Remember the combination which made the package unsatisfiable.
+            Nogood nogood;
+            nogood.mPackage = failed.mPackage;
+            nogood.mActive = mPackages[failed.mPackage].mActive;
+            nogood.mNoCandidates = failed.mCandidates.empty();
+            nogood.mRejections = std::move(failed.mRejections);
+            std::uint32_t latest = conflict.begin()->first;
+            for (auto & c : conflict) {
+                const std::uint32_t pkg = c.first;
+                nogood.mTerms.push_back(Term{pkg, static_cast<std::uint32_t>(mPackages[pkg].mAssigned), c.second});
+                if (mPackages[pkg].mLevel > mPackages[latest].mLevel) {
+                    latest = pkg;
+                }
+            }
+            const std::uint32_t nogoodIndex = static_cast<std::uint32_t>(mNogoods.size());
+            mNogoods.emplace_back(std::move(nogood));
+            for (auto & c : conflict) {
+                mPackages[c.first].mNogoods.push_back(nogoodIndex);
+            }
+
+            const std::size_t level = mPackages[latest].mLevel;
+            while (mDecisions.size() - 1 > level) {
+                unassign(mDecisions.back().mPackage);
+                mDecisions.pop_back();
+            }
+            Decision & target = mDecisions.back();
+            conflict.erase(latest);
+            for (auto & c : conflict) {
+                addCondition(c.first, c.second, target.mConflict);
+            }
+            target.mRejections.push_back(Rejection{static_cast<std::uint32_t>(mPackages[latest].mAssigned),
+                                                   RejectionType::Nogood, nogoodIndex, {}});
+            unassign(latest);
+            return true;
+        }
+
+        //-------------------------------------------------------------------------
+
+        std::string versionName(const std::uint32_t pkg, const std::uint32_t version) const {
+            return mPackages[pkg].mName + " " + mPackages[pkg].mVersions[version].toString(true, true);
+        }
+
+        std::string sourceName(const Edge & e) const {
+            return e.mSource == gRoot ? std::string("root") : versionName(e.mSource, e.mSourceVersion);
+        }
+
+        void collectEdges(const std::vector<std::uint32_t> & active, const std::vector<Rejection> & rejections,
+                          std::vector<bool> & visited, EdgeKeys & outKeys) const {
+            for (auto e : active) {
+                outKeys.insert(edgeKey(e));
+            }
+            for (auto & r : rejections) {
+                if (r.mType != RejectionType::Nogood) {
+                    outKeys.insert(edgeKey(r.mIndex));
+                    for (auto o : r.mOthers) {
+                        outKeys.insert(edgeKey(o));
+                    }
+                }
+                else if (!visited[r.mIndex]) {
+                    visited[r.mIndex] = true;
+                    const Nogood & nogood = mNogoods[r.mIndex];
+                    collectEdges(nogood.mActive, nogood.mRejections, visited, outKeys);
+                }
+            }
+        }
+
+        // Each nogood is explained once, the next references point to the explanation above.
+        void explain(const std::uint32_t pkg, const std::vector<std::uint32_t> & active, const bool noCandidates,
+                     const std::vector<Rejection> & rejections, const std::string & indent,
+                     std::vector<bool> & explained, std::vector<std::string> & outLines) const {
+            const Package & p = mPackages[pkg];
+            outLines.emplace_back(indent + "no version of " + p.mName + " satisfies the requirements:");
+            for (auto e : active) {
+                outLines.emplace_back(indent + "    " + sourceName(mEdges[e]) + " requires " +
+                                      p.mName + " " + rangeText(e));
+            }
+            if (noCandidates) {
+                outLines.emplace_back(p.mVersions.empty()
+                                          ? indent + "    there are no versions of " + p.mName
+                                          : indent + "    none of the available versions of " + p.mName + " matches them");
+            }
+            for (auto & r : rejections) {
+                const std::string name = indent + "    " + versionName(pkg, r.mVersion);
+                if (r.mType != RejectionType::Nogood) {
+                    const Edge & e = mEdges[r.mIndex];
+                    const Package & t = mPackages[e.mTarget];
+                    std::string line = name + " requires " + t.mName + " " + rangeText(r.mIndex);
+                    if (r.mType == RejectionType::Assigned) {
+                        line += " but " + t.mName + " is already selected with other version";
+                    }
+                    else if (r.mType == RejectionType::Constraints && r.mOthers.empty()) {
+                        line += " but no version of " + t.mName + " matches it";
+                    }
+                    else if (r.mType == RejectionType::Constraints) {
+                        line += " which conflicts with:";
+                        for (auto a : r.mOthers) {
+                            line += " " + sourceName(mEdges[a]) + " -> " + rangeText(a) + ";";
+                        }
+                    }
+                    outLines.emplace_back(line);
+                    continue;
+                }
+                const Nogood & nogood = mNogoods[r.mIndex];
+                std::string line = name + " can't be selected";
+                bool first = true;
+                for (auto & t : nogood.mTerms) {
+                    if (t.mPackage != pkg) {
+                        line += (first ? " together with " : ", ") + versionName(t.mPackage, t.mVersion);
+                        first = false;
+                    }
+                }
+                if (explained[r.mIndex]) {
+                    outLines.emplace_back(line + " (see above)");
+                    continue;
+                }
+                explained[r.mIndex] = true;
+                outLines.emplace_back(line + " because");
+                explain(nogood.mPackage, nogood.mActive, nogood.mNoCandidates, nogood.mRejections,
+                        indent + "        ", explained, outLines);
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        Provider & mProvider;
+        const EdgeKeys * mEnabled;
+        std::vector<Package> mPackages;
+        std::unordered_map<std::string, std::uint32_t> mIndices;
+        std::vector<Edge> mEdges;
+        std::vector<Constraint> mConstraints;
+        std::map<std::pair<std::uint32_t, std::string>, std::uint32_t> mConstraintIndices;
+        // Sorted constraint indices -> allowed versions.
+        std::map<std::vector<std::uint32_t>, Bitset> mIntersections;
+        std::vector<Nogood> mNogoods;
+        std::vector<Decision> mDecisions;
+        std::size_t mAttempts = 0;
+
+    };
+
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+void sts::semver::MemoryProvider::add(const std::string & package, const SemVersion & version,
+                                      const std::vector<Dependency> & dependencies) {
+    auto & items = mPackages[package];
+    for (auto & i : items) {
+        if (i.mVersion.compare(version, true, true)) {
+            i.mDependencies = dependencies;
+            return;
+        }
+    }
+    Item item;
+    item.mVersion = version;
+    item.mDependencies = dependencies;
+    items.emplace_back(std::move(item));
+}
+
+std::vector<sts::semver::SemVersion> sts::semver::MemoryProvider::versions(const std::string & package) {
+    std::vector<SemVersion> res;
+    const auto found = mPackages.find(package);
+    if (found != mPackages.end()) {
+        for (auto & i : found->second) {
+            res.push_back(i.mVersion);
+        }
+    }
+    return res;
+}
+
+std::vector<sts::semver::Dependency> sts::semver::MemoryProvider::dependencies(const std::string & package,
+                                                                               const SemVersion & version) {
+    const auto found = mPackages.find(package);
+    if (found != mPackages.end()) {
+        for (auto & i : found->second) {
+            if (i.mVersion.compare(version, true, true)) {
+                return i.mDependencies;
+            }
+        }
+    }
+    return std::vector<Dependency>();
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
+
+sts::semver::Resolver::Result sts::semver::Resolver::resolve(const std::vector<Dependency> & requirements) {
+    Result res;
+    Solver solver(mProvider);
+    res.mResolved = solver.run(requirements);
+    res.mAttempts = solver.attempts();
+    if (res.mResolved) {
+        solver.selected(res.mVersions);
+        return res;
+    }
+
+    // The conflict is explained with a minimal set of the dependencies which still can't be satisfied.
+    // It starts from the dependencies used by the proof of the conflict, then each one is removed
+    // if the rest still conflicts. After a successful removal the set is reduced to the dependencies
+    // used by the new proof. The last failed run is kept, its proof uses only the final set.
+    std::unique_ptr<EdgeKeys> failedKeys(new EdgeKeys(solver.conflictEdges()));
+    std::unique_ptr<Solver> failed(new Solver(mProvider, failedKeys.get()));
+    if (failed->run(requirements)) {
+        // shouldn't happen, the full explanation is better than nothing
+        res.mConflict = solver.explain();
+        return res;
+    }
+    EdgeKeys core = failed->conflictEdges();
+    const std::vector<EdgeKey> order(core.begin(), core.end());
+    for (auto & key : order) {
+        if (core.find(key) == core.end()) {
+            continue;
+        }
+        std::unique_ptr<EdgeKeys> reduced(new EdgeKeys(core));
+        reduced->erase(key);
+        std::unique_ptr<Solver> check(new Solver(mProvider, reduced.get()));
+        if (!check->run(requirements)) {
+            core = check->conflictEdges();
+            // the solver refers to its keys so it is released first
+            failed = std::move(check);
+            failedKeys = std::move(reduced);
+        }
+    }
+    res.mConflict = failed->explain();
+    return res;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
@@ -0,0 +1,356 @@
+#pragma once
+
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/*
+ * Hand-written scanner for the Semantic Versioning grammar:
+ *     (0|[1-9][0-9]*)\.(0|[1-9][0-9]*)\.(0|[1-9][0-9]*)
+ *     (\-[0-9a-z-]+[\.0-9a-z-]*)?(\+[0-9a-z-]+[\.0-9a-z-]*)?   (case insensitive)
+ * Pre-release and build tags are checked 8 bytes per step (SWAR),
+ * so long tags don't cost a branch per character.
+ * The lenient mode additionally accepts surrounding whitespace, a "v" or "=" prefix
+ * and missing minor/patch numbers in the same pass.
+ */
+
+namespace sts {
+namespace semver {
+namespace scanner {
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+
+    const std::uint64_t gOnes = 0x0101010101010101ULL;
+    const std::uint64_t gHighBits = 0x8080808080808080ULL;
+
+    inline std::uint64_t load64(const char * ptr) {
+        std::uint64_t word;
+        std::memcpy(&word, ptr, sizeof(word));
+        return word;
+    }
+
+    // Sets the high bit of each byte which is in [lo, hi].
+    // All the bytes must have the high bit cleared.
+    inline std::uint64_t bytesInRange(const std::uint64_t word, const unsigned lo, const unsigned hi) {
+        return (word + gOnes * (0x80 - lo)) & ~(word + gOnes * (0x7F - hi)) & gHighBits;
+    }
+
+    // [0-9a-zA-Z.-] for all 8 bytes.
+    inline bool isTagWord(const std::uint64_t word) {
+        if (word & gHighBits) {
+            return false;
+        }
+        const std::uint64_t mask = bytesInRange(word, '0', '9') |
+                                   bytesInRange(word, '-', '.') |
+                                   bytesInRange(word | gOnes * 0x20, 'a', 'z');
+        return mask == gHighBits;
+    }
+
+    inline bool isDigit(const char ch) {
+        return ch >= '0' && ch <= '9';
+    }
+
+    // [0-9a-zA-Z.-]
+    inline bool isTagChar(const char ch) {
+        const char lower = static_cast<char>(ch | 0x20);
+        return isDigit(ch) || ch == '-' || ch == '.' || (lower >= 'a' && lower <= 'z');
+    }
+
+    // Returns pointer to the first char which isn't [0-9a-zA-Z.-].
+    inline const char * skipTagChars(const char * ptr, const char * end) {
+        while (end - ptr >= 8 && isTagWord(load64(ptr))) {
+            ptr += 8;
+        }
+        while (ptr != end && isTagChar(*ptr)) {
+            ++ptr;
+        }
+        return ptr;
+    }
+
+    inline const char * skipDigits(const char * ptr, const char * end) {
+        while (ptr != end && isDigit(*ptr)) {
+            ++ptr;
+        }
+        return ptr;
+    }
+
+    inline const char * skipZeros(const char * ptr, const char * end) {
+        while (ptr != end && *ptr == '0') {
+            ++ptr;
+        }
+        return ptr;
+    }
+
+    // 0|[1-9][0-9]*
+    inline const char * scanNumber(const char * ptr, const char * end) {
+        if (ptr == end || !isDigit(*ptr)) {
+            return nullptr;
+        }
+        if (*ptr == '0') {
+            return ptr + 1;
+        }
+        return skipDigits(ptr, end);
+    }
+
+    // [0-9a-z-]+[\.0-9a-z-]*
+    inline const char * scanTag(const char * ptr, const char * end) {
+        if (ptr == end || *ptr == '.' || !isTagChar(*ptr)) {
+            return nullptr;
+        }
+        return skipTagChars(ptr + 1, end);
+    }
+
+    // Flags of the lenient mode, the values are the same as SemVersion::Leniency.
+    const std::uint8_t gLenientPrefix = 1 << 0;
+    const std::uint8_t gLenientMissingMinor = 1 << 1;
+    const std::uint8_t gLenientMissingPatch = 1 << 2;
+    const std::uint8_t gLenientWhitespace = 1 << 3;
+
+    // Whitespace which separates the versions in the streams, it is also skipped around a lenient version.
+    inline bool isDelimiter(const char ch) {
+        return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t' || ch == '\v' || ch == '\f';
+    }
+
+    // Positions of the version parts in the scanned string.
+    struct Parts {
+        const char * mNumbers[3];
+        const char * mNumbersEnd[3];
+        const char * mPreRelease = nullptr;
+        const char * mPreReleaseEnd = nullptr;
+        const char * mBuild = nullptr;
+        const char * mBuildEnd = nullptr;
+    };
+
+    // Converts the digits, returns false if the value doesn't fit uint32.
+    inline bool toUint32(const char * ptr, const char * end, std::uint32_t & outValue) {
+        std::uint64_t value = 0;
+        for (; ptr != end; ++ptr) {
+            value = value * 10 + static_cast<std::uint64_t>(*ptr - '0');
+            if (value > UINT32_MAX) {
+                return false;
+            }
+        }
+        outValue = static_cast<std::uint32_t>(value);
+        return true;
+    }
+
+    // Writes the decimal digits, the buffer must have 10 bytes. Returns the pointer after the digits.
+    inline char * writeUint32(std::uint32_t value, char * out) {
+        char digits[10];
+        std::size_t count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        while (count != 0) {
+            *out++ = digits[--count];
+        }
+        return out;
+    }
+
+    // Checks the whole string, the parts are filled if outParts isn't nullptr.
+    // The allowed flags enable the lenient mode, the applied ones are written to outApplied if the string is valid.
+    // A missing number has empty part which is converted to 0.
+    inline bool scanVersion(const char * ptr, const std::size_t length, Parts * outParts = nullptr,
+                            const std::uint8_t allowed = 0, std::uint8_t * outApplied = nullptr) {
+        const char * end = ptr + length;
+        std::uint8_t applied = 0;
+        if (allowed != 0) {
+            if (allowed & gLenientWhitespace) {
+                const char * begin = ptr;
+                const char * last = end;
+                while (ptr != end && isDelimiter(*ptr)) {
+                    ++ptr;
+                }
+                while (end != ptr && isDelimiter(*(end - 1))) {
+                    --end;
+                }
+                if (ptr != begin || end != last) {
+                    applied |= gLenientWhitespace;
+                }
+            }
+            if (allowed & gLenientPrefix) {
+                if (ptr != end && *ptr == '=') {
+                    ++ptr;
+                    applied |= gLenientPrefix;
+                }
+                if (ptr != end && (*ptr | 0x20) == 'v') {
+                    ++ptr;
+                    applied |= gLenientPrefix;
+                }
+            }
+        }
+        for (int i = 0; i < 3; ++i) {
+            if (i != 0) {
+                if (ptr == end || *ptr != '.') {
+                    const std::uint8_t missing = i == 1 ? gLenientMissingMinor : gLenientMissingPatch;
+                    if ((allowed & missing) != missing) {
+                        return false;
+                    }
+                    applied |= missing;
+                    if (outParts) {
+                        for (int j = i; j < 3; ++j) {
+                            outParts->mNumbers[j] = ptr;
+                            outParts->mNumbersEnd[j] = ptr;
+                        }
+                    }
+                    break;
+                }
+                ++ptr;
+            }
+            const char * numberEnd = scanNumber(ptr, end);
+            if (!numberEnd) {
+                return false;
+            }
+            if (outParts) {
+                outParts->mNumbers[i] = ptr;
+                outParts->mNumbersEnd[i] = numberEnd;
+            }
+            ptr = numberEnd;
+        }
+        if (ptr != end && *ptr == '-') {
+            const char * tagEnd = scanTag(ptr + 1, end);
+            if (!tagEnd) {
+                return false;
+            }
+            if (outParts) {
+                outParts->mPreRelease = ptr + 1;
+                outParts->mPreReleaseEnd = tagEnd;
+            }
+            ptr = tagEnd;
+        }
+        if (ptr != end && *ptr == '+') {
+            const char * tagEnd = scanTag(ptr + 1, end);
+            if (!tagEnd) {
+                return false;
+            }
+            if (outParts) {
+                outParts->mBuild = ptr + 1;
+                outParts->mBuildEnd = tagEnd;
+            }
+            ptr = tagEnd;
+        }
+        if (ptr != end) {
+            return false;
+        }
+        if (outApplied) {
+            *outApplied = applied;
+        }
+        return true;
+    }
+
+    // Scans the string and converts the numbers.
+    // Returns false if the string isn't valid or a number doesn't fit 32 bits.
+    inline bool parseParts(const char * ptr, const std::size_t length, Parts & outParts, std::uint32_t (&outNumbers)[3],
+                           const std::uint8_t allowed = 0, std::uint8_t * outApplied = nullptr) {
+        return ptr && scanVersion(ptr, length, &outParts, allowed, outApplied) &&
+               toUint32(outParts.mNumbers[0], outParts.mNumbersEnd[0], outNumbers[0]) &&
+               toUint32(outParts.mNumbers[1], outParts.mNumbersEnd[1], outNumbers[1]) &&
+               toUint32(outParts.mNumbers[2], outParts.mNumbersEnd[2], outNumbers[2]);
+    }
+
+    // Compares one dot-separated pre-release identifier.
+    inline int compareIdentifier(const char * l, const std::size_t lLen, const char * r, const std::size_t rLen) {
+        const bool lNumeric = lLen != 0 && skipDigits(l, l + lLen) == l + lLen;
+        const bool rNumeric = rLen != 0 && skipDigits(r, r + rLen) == r + rLen;
+        if (lNumeric != rNumeric) {
+            // numeric identifiers always have lower precedence
+            return lNumeric ? -1 : 1;
+        }
+        if (lNumeric) {
+            const char * lStart = skipZeros(l, l + lLen);
+            const char * rStart = skipZeros(r, r + rLen);
+            const std::size_t lDigits = static_cast<std::size_t>(l + lLen - lStart);
+            const std::size_t rDigits = static_cast<std::size_t>(r + rLen - rStart);
+            if (lDigits != rDigits) {
+                return lDigits < rDigits ? -1 : 1;
+            }
+            const int res = std::memcmp(lStart, rStart, lDigits);
+            return res < 0 ? -1 : (res > 0 ? 1 : 0);
+        }
+        const int res = std::memcmp(l, r, lLen < rLen ? lLen : rLen);
+        if (res != 0) {
+            return res < 0 ? -1 : 1;
+        }
+        return lLen == rLen ? 0 : (lLen < rLen ? -1 : 1);
+    }
+
+    // Compares the pre-release parts by the semver.org precedence rules.
+    inline int comparePreRelease(const char * l, const std::size_t lLen, const char * r, const std::size_t rLen) {
+        if (lLen == 0 || rLen == 0) {
+            // a version without pre-release has higher precedence
+            return lLen == rLen ? 0 : (lLen == 0 ? 1 : -1);
+        }
+        const char * lEnd = l + lLen;
+        const char * rEnd = r + rLen;
+        for (;;) {
+            const char * lDot = static_cast<const char *>(std::memchr(l, '.', static_cast<std::size_t>(lEnd - l)));
+            const char * rDot = static_cast<const char *>(std::memchr(r, '.', static_cast<std::size_t>(rEnd - r)));
+            const char * lIdEnd = lDot ? lDot : lEnd;
+            const char * rIdEnd = rDot ? rDot : rEnd;
+            const int res = compareIdentifier(l, static_cast<std::size_t>(lIdEnd - l),
+                                              r, static_cast<std::size_t>(rIdEnd - r));
+            if (res != 0) {
+                return res;
+            }
+            if (!lDot || !rDot) {
+                // a larger set of identifiers has higher precedence
+                return lDot == rDot ? 0 : (lDot ? 1 : -1);
+            }
+            l = lDot + 1;
+            r = rDot + 1;
+        }
+    }
+
+    inline int compareNumber(const std::uint32_t left, const std::uint32_t right) {
+        return left == right ? 0 : (left < right ? -1 : 1);
+    }
+
+    // Compares the versions by the semver.org precedence rules, the numbers are major, minor and patch.
+    inline int comparePrecedence(const std::uint32_t (&lNumbers)[3], const char * lPreRelease, const std::size_t lPreReleaseLen,
+                                 const std::uint32_t (&rNumbers)[3], const char * rPreRelease, const std::size_t rPreReleaseLen) {
+        for (int i = 0; i < 3; ++i) {
+            if (lNumbers[i] != rNumbers[i]) {
+                return compareNumber(lNumbers[i], rNumbers[i]);
+            }
+        }
+        return comparePreRelease(lPreRelease, lPreReleaseLen, rPreRelease, rPreReleaseLen);
+    }
+
+    /**************************************************************************************************/
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**************************************************************************************************/
+}
+}
+}
@@ -27,13 +27,23 @@
 **  Contacts: www.steptosky.com
 */
 
-#include <sstream>
+#include <cstring>
 #include "sts/semver/SemVersion.h"
+#include "Scanner.h"
 
 /**************************************************************************************************/
 /////////////////////////////////////////* Static area *////////////////////////////////////////////
 /**************************************************************************************************/
 
+// the definition of the deprecated member mustn't fail the build with the warnings as errors
+#if defined(_MSC_VER)
+#   pragma warning(push)
+#   pragma warning(disable : 4996)
+#elif defined(__GNUC__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+
 const std::regex sts::semver::SemVersion::mRegex = std::regex("^(0|[1-9][0-9]*)"
                                                               "\\.(0|[1-9][0-9]*)"
                                                               "\\.(0|[1-9][0-9]*)"
@@ -42,6 +52,12 @@ const std::regex sts::semver::SemVersion::mRegex = std::regex("^(0|[1-9][0-9]*)"
                                                               std::regex_constants::ECMAScript |
                                                               std::regex_constants::icase);
 
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#elif defined(__GNUC__)
+#   pragma GCC diagnostic pop
+#endif
+
 /**************************************************************************************************/
 //////////////////////////////////////////* Functions */////////////////////////////////////////////
 /**************************************************************************************************/
@@ -59,28 +75,119 @@ bool sts::semver::SemVersion::compare(const SemVersion & other, const bool preRe
     return true;
 }
 
+int sts::semver::SemVersion::comparePrecedence(const SemVersion & other) const STS_SEMVER_NOEXCEPT {
+    const std::uint32_t numbers[3] = {mMajor, mMinor, mPatch};
+    const std::uint32_t otherNumbers[3] = {other.mMajor, other.mMinor, other.mPatch};
+    return scanner::comparePrecedence(numbers, mPreRelease.data(), mPreRelease.length(),
+                                      otherNumbers, other.mPreRelease.data(), other.mPreRelease.length());
+}
+
 sts::semver::SemVersion sts::semver::SemVersion::parse(const std::string & version) {
-    auto match = std::smatch();
-    if (!regex_match(version, match, mRegex)) {
-        return SemVersion();
+    return parse(version.data(), version.length());
+}
+
+bool sts::semver::SemVersion::parse(const char * version, const std::size_t length, SemVersion & outVersion) {
+    return parseLenient(version, length, outVersion, LenientNone, nullptr);
+}
+
+bool sts::semver::SemVersion::parseLenient(const char * version, const std::size_t length, SemVersion & outVersion,
+                                           const std::uint8_t allowed, std::uint8_t * outApplied) {
+    static_assert(LenientPrefix == scanner::gLenientPrefix && LenientMissingMinor == scanner::gLenientMissingMinor &&
+                  LenientMissingPatch == scanner::gLenientMissingPatch && LenientWhitespace == scanner::gLenientWhitespace,
+                  "leniency flags mismatch");
+    scanner::Parts parts;
+    std::uint32_t numbers[3];
+    if (!scanner::parseParts(version, length, parts, numbers, allowed, outApplied)) {
+        if (outApplied) {
+            *outApplied = LenientNone;
+        }
+        outVersion.clear();
+        return false;
     }
-    return SemVersion(atoi(match[1].str().c_str()),
-                      atoi(match[2].str().c_str()),
-                      atoi(match[3].str().c_str()),
-                      match[4],
-                      match[5]);
+    outVersion.mMajor = numbers[0];
+    outVersion.mMinor = numbers[1];
+    outVersion.mPatch = numbers[2];
+    outVersion.mPreRelease.assign(parts.mPreRelease, parts.mPreReleaseEnd);
+    outVersion.mBuild.assign(parts.mBuild, parts.mBuildEnd);
+    return true;
+}
+
+bool sts::semver::SemVersion::isValid(const char * version, const std::size_t length) STS_SEMVER_NOEXCEPT {
+    return version ? scanner::scanVersion(version, length) : false;
+}
+
+std::size_t sts::semver::SemVersion::isValidBatch(const char * const * versions, const std::size_t * lengths,
+                                                  bool * outResults, const std::size_t count) STS_SEMVER_NOEXCEPT {
+    std::size_t validCount = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const char * version = versions[i];
+        bool res = false;
+        if (version) {
+            res = scanner::scanVersion(version, lengths ? lengths[i] : std::strlen(version));
+        }
+        if (outResults) {
+            outResults[i] = res;
+        }
+        validCount += res ? 1 : 0;
+    }
+    return validCount;
+}
+
+bool sts::semver::SemVersion::bumpPreRelease() {
+    if (mPreRelease.empty()) {
+        if (mPatch == UINT32_MAX) {
+            return false;
+        }
+        mBuild.clear();
+        ++mPatch;
+        mPreRelease.push_back('0');
+        return true;
+    }
+    mBuild.clear();
+    const std::size_t dot = mPreRelease.find_last_of('.');
+    const std::size_t start = dot == std::string::npos ? 0 : dot + 1;
+    const char * id = mPreRelease.data() + start;
+    const char * end = mPreRelease.data() + mPreRelease.length();
+    if (id == end || scanner::skipDigits(id, end) != end) {
+        mPreRelease.append(".0");
+        return true;
+    }
+    std::size_t pos = mPreRelease.length();
+    while (pos != start) {
+        --pos;
+        if (mPreRelease[pos] != '9') {
+            ++mPreRelease[pos];
+            return true;
+        }
+        mPreRelease[pos] = '0';
+    }
+    mPreRelease.insert(start, 1, '1');
+    return true;
 }
 
 std::string sts::semver::SemVersion::toString(const bool preRelease, const bool build) const {
-    std::ostringstream stream;
-    stream << mMajor << '.' << mMinor << '.' << mPatch;
-    if (preRelease && !mPreRelease.empty()) {
-        stream << '-' << mPreRelease;
+    // 3 numbers with 10 digits at most and 2 dots
+    char numbers[32];
+    char * ptr = scanner::writeUint32(mMajor, numbers);
+    *ptr++ = '.';
+    ptr = scanner::writeUint32(mMinor, ptr);
+    *ptr++ = '.';
+    ptr = scanner::writeUint32(mPatch, ptr);
+    const bool withPreRelease = preRelease && !mPreRelease.empty();
+    const bool withBuild = build && !mBuild.empty();
+    std::string res;
+    res.reserve(static_cast<std::size_t>(ptr - numbers) +
+                (withPreRelease ? mPreRelease.length() + 1 : 0) + (withBuild ? mBuild.length() + 1 : 0));
+    res.append(numbers, ptr);
+    if (withPreRelease) {
+        res.push_back('-');
+        res.append(mPreRelease);
     }
-    if (build && !mBuild.empty()) {
-        stream << '+' << mBuild;
+    if (withBuild) {
+        res.push_back('+');
+        res.append(mBuild);
     }
-    return stream.str();
+    return res;
 }
 
 /**************************************************************************************************/
@@ -0,0 +1,319 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "sts/semver/StatsPipeline.h"
+#include "sts/semver/StreamParser.h"
+#include "BoundedQueue.h"
+#include "Scanner.h"
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Local *////////////////////////////////////////////////
+/**************************************************************************************************/
+
+namespace {
+
+    using sts::semver::BoundedQueue;
+    using sts::semver::SemVersion;
+    using sts::semver::StatsPipeline;
+    using sts::semver::StreamParser;
+    using sts::semver::VersionStats;
+    using sts::semver::scanner::isDelimiter;
+
+    typedef std::vector<char> Buffer;
+
+    // A piece of input which ends on a whitespace boundary.
+    struct Slice {
+        const char * mData = nullptr;
+        std::size_t mSize = 0;
+        // Owner of the data if it was read into a buffer otherwise nullptr.
+        Buffer * mBuffer = nullptr;
+    };
+
+    // Returns the position after the last delimiter or 0 if there is no delimiter.
+    std::size_t lastDelimiterEnd(const char * data, std::size_t size) {
+        while (size != 0 && !isDelimiter(data[size - 1])) {
+            --size;
+        }
+        return size;
+    }
+
+    std::size_t firstDelimiter(const char * data, const std::size_t size) {
+        std::size_t pos = 0;
+        while (pos != size && !isDelimiter(data[pos])) {
+            ++pos;
+        }
+        return pos;
+    }
+
+    std::size_t threadsCount(const StatsPipeline::Config & config) {
+        if (config.mThreads != 0) {
+            return config.mThreads;
+        }
+        const std::size_t hw = std::thread::hardware_concurrency();
+        return hw != 0 ? hw : 1;
+    }
+
+    /*
+     * Owns the worker threads.
+     * The producer pushes the slices into mFull, the workers return the buffers through mFree.
+     */
+    class Workers {
+    public:
+
+        Workers(const StatsPipeline::Config & config, const std::size_t threads, const std::size_t freeCapacity)
+            : mFull(config.mQueueSize != 0 ? config.mQueueSize : threads * 2),
+              mFree(freeCapacity),
+              mStats(threads),
+              mErrors(threads) {
+            mThreads.reserve(threads);
+            for (std::size_t i = 0; i < threads; ++i) {
+                mThreads.emplace_back(&Workers::work, this, std::cref(config), i);
+            }
+        }
+
+        Workers(const Workers &) = delete;
+        Workers & operator=(const Workers &) = delete;
+
+        ~Workers() {
+            stop();
+        }
+
+        // Returns false if the pipeline is stopped.
+        bool push(const Slice & slice) {
+            return !mFailed && mFull.push(slice);
+        }
+
+        // Returns false if the pipeline is stopped.
+        bool takeFreeBuffer(Buffer *& outBuffer) {
+            return !mFailed && mFree.pop(outBuffer);
+        }
+
+        void returnBuffer(Buffer * buffer) {
+            mFree.push(buffer);
+        }
+
+        VersionStats finish(const std::size_t extraInvalidCount) {
+            stop();
+            for (auto & e : mErrors) {
+                if (e) {
+                    std::rethrow_exception(e);
+                }
+            }
+            VersionStats res;
+            res.mInvalidCount = extraInvalidCount;
+            for (auto & s : mStats) {
+                res.merge(s);
+            }
+            return res;
+        }
+
+    private:
+
+        void stop() {
+            mFull.close();
+            for (auto & t : mThreads) {
+                if (t.joinable()) {
+                    t.join();
+                }
+            }
+            mFree.close();
+        }
+
+        void work(const StatsPipeline::Config & config, const std::size_t index) {
+            VersionStats & stats = mStats[index];
+            StreamParser parser([&](const SemVersion & version) {
+                if (!config.mFilter || config.mFilter(version)) {
+                    stats.add(version);
+                }
+            }, config.mMaxTagLength);
+
+            Slice slice;
+            while (mFull.pop(slice)) {
+                // After an error the rest of the queue is dropped.
+                if (!mFailed) {
+                    try {
+                        parser.feed(slice.mData, slice.mSize);
+                        parser.finish();
+                    }
+                    catch (...) {
+                        mErrors[index] = std::current_exception();
+                        fail();
+                    }
+                }
+                if (slice.mBuffer) {
+                    mFree.push(slice.mBuffer);
+                }
+            }
+            stats.mInvalidCount += parser.invalidCount();
+        }
+
+        // Stops the producer and the other workers, the error is re-thrown from finish.
+        void fail() {
+            mFailed = true;
+            mFull.close();
+            mFree.close();
+        }
+
+        std::atomic<bool> mFailed{false};
+        BoundedQueue<Slice> mFull;
+        BoundedQueue<Buffer *> mFree;
+        std::vector<VersionStats> mStats;
+        std::vector<std::exception_ptr> mErrors;
+        std::vector<std::thread> mThreads;
+
+    };
+
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+sts::semver::VersionStats sts::semver::StatsPipeline::run(const Reader & reader, const Config & config) {
+    const std::size_t threads = threadsCount(config);
+    const std::size_t chunkSize = std::max<std::size_t>(config.mChunkSize, 1);
+    // One more byte so a full buffer without a delimiter means a token longer than the chunk size.
+    const std::size_t bufferSize = chunkSize + 1;
+    const std::size_t queueSize = config.mQueueSize != 0 ? config.mQueueSize : threads * 2;
+    // Each buffer is either in the queue, or in a worker, or in the reader.
+    const std::size_t buffersCount = queueSize + threads + 1;
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    buffers.reserve(buffersCount);
+
+    Workers workers(config, threads, buffersCount);
+    for (std::size_t i = 0; i < buffersCount; ++i) {
+        buffers.emplace_back(new Buffer(bufferSize));
+        workers.returnBuffer(buffers.back().get());
+    }
+
+    Buffer carry;
+    carry.reserve(bufferSize);
+    std::size_t invalidCount = 0;
+    bool skipping = false;
+    bool eof = false;
+    while (!eof) {
+        Buffer * buffer = nullptr;
+        if (!workers.takeFreeBuffer(buffer)) {
+            break;
+        }
+        char * data = buffer->data();
+        std::size_t size = carry.size();
+        std::copy(carry.begin(), carry.end(), data);
+        carry.clear();
+        while (size < bufferSize) {
+            const std::size_t read = reader(data + size, bufferSize - size);
+            if (read == 0) {
+                eof = true;
+                break;
+            }
+            size += read;
+        }
+        if (skipping) {
+            // The rest of a token which is longer than a chunk.
+            const std::size_t pos = firstDelimiter(data, size);
+            skipping = pos == size && !eof;
+            std::memmove(data, data + pos, size - pos);
+            size -= pos;
+        }
+        if (!eof) {
+            const std::size_t end = lastDelimiterEnd(data, size);
+            if (end == 0 && size != 0) {
+                // The token is longer than a chunk, it is considered as invalid.
+                ++invalidCount;
+                skipping = true;
+                size = 0;
+            }
+            else {
+                carry.assign(data + end, data + size);
+                size = end;
+            }
+        }
+        if (size == 0) {
+            workers.returnBuffer(buffer);
+            continue;
+        }
+        Slice slice;
+        slice.mData = data;
+        slice.mSize = size;
+        slice.mBuffer = buffer;
+        if (!workers.push(slice)) {
+            break;
+        }
+    }
+    return workers.finish(invalidCount);
+}
+
+sts::semver::VersionStats sts::semver::StatsPipeline::run(const char * data, const std::size_t length,
+                                                          const Config & config) {
+    const std::size_t threads = threadsCount(config);
+    const std::size_t chunkSize = std::max<std::size_t>(config.mChunkSize, 1);
+    Workers workers(config, threads, 1);
+
+    const char * end = data + length;
+    std::size_t invalidCount = 0;
+    while (data != end) {
+        std::size_t size = std::min<std::size_t>(chunkSize, static_cast<std::size_t>(end - data));
+        std::size_t skip = 0;
+        if (data + size != end && !isDelimiter(data[size])) {
+            // Extend the slice up to the end of the last token unless the token is longer than a chunk,
+            // such a token is considered as invalid the same way as in the reader version.
+            const std::size_t tokenBegin = lastDelimiterEnd(data, size);
+            const std::size_t tokenEnd = size + firstDelimiter(data + size, static_cast<std::size_t>(end - data) - size);
+            if (tokenEnd - tokenBegin > chunkSize) {
+                ++invalidCount;
+                skip = tokenEnd - tokenBegin;
+                size = tokenBegin;
+            }
+            else {
+                size = tokenEnd;
+            }
+        }
+        if (size != 0) {
+            Slice slice;
+            slice.mData = data;
+            slice.mSize = size;
+            if (!workers.push(slice)) {
+                break;
+            }
+        }
+        data += size + skip;
+    }
+    return workers.finish(invalidCount);
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
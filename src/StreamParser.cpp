@@ -0,0 +1,202 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include "sts/semver/StreamParser.h"
+#include "Scanner.h"
+
+/**************************************************************************************************/
+////////////////////////////////////////* Constructors/Destructor *//////////////////////////////////
+/**************************************************************************************************/
+
+sts::semver::StreamParser::StreamParser(Callback callback, const std::size_t maxTagLength)
+    : mCallback(std::move(callback)),
+      mMaxTagLength(maxTagLength) {}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+std::size_t sts::semver::StreamParser::feed(const char * data, const std::size_t length) {
+    const std::size_t parsedBefore = mParsedCount;
+    const char * ptr = data;
+    const char * end = data + length;
+    while (ptr != end) {
+        const char ch = *ptr;
+        switch (mState) {
+            case State::Delimiter: {
+                if (scanner::isDelimiter(ch)) {
+                    ++ptr;
+                    break;
+                }
+                mVersion.clear();
+                mState = State::Major;
+                break;
+            }
+            case State::Major:
+            case State::Minor: {
+                ++ptr;
+                if (scanner::isDigit(ch)) {
+                    if (!pushDigit(ch)) {
+                        invalidate(false);
+                    }
+                    break;
+                }
+                if (ch != '.' || !endNumber(mState == State::Major ? mVersion.mMajor : mVersion.mMinor)) {
+                    invalidate(scanner::isDelimiter(ch));
+                    break;
+                }
+                mState = mState == State::Major ? State::Minor : State::Patch;
+                break;
+            }
+            case State::Patch: {
+                ++ptr;
+                if (scanner::isDigit(ch)) {
+                    if (!pushDigit(ch)) {
+                        invalidate(false);
+                    }
+                    break;
+                }
+                const bool delimiter = scanner::isDelimiter(ch);
+                if ((ch != '-' && ch != '+' && !delimiter) || !endNumber(mVersion.mPatch)) {
+                    invalidate(delimiter);
+                    break;
+                }
+                if (delimiter) {
+                    emit();
+                }
+                else {
+                    mState = ch == '-' ? State::PreReleaseFirst : State::BuildFirst;
+                }
+                break;
+            }
+            case State::PreReleaseFirst:
+            case State::BuildFirst: {
+                if (ch == '.' || !scanner::isTagChar(ch)) {
+                    ++ptr;
+                    invalidate(scanner::isDelimiter(ch));
+                    break;
+                }
+                mState = mState == State::PreReleaseFirst ? State::PreRelease : State::Build;
+                break;
+            }
+            case State::PreRelease:
+            case State::Build: {
+                std::string & tag = mState == State::PreRelease ? mVersion.mPreRelease : mVersion.mBuild;
+                const char * tagEnd = scanner::skipTagChars(ptr, end);
+                if (tagEnd != ptr) {
+                    if (static_cast<std::size_t>(tagEnd - ptr) > mMaxTagLength - tag.length()) {
+                        ptr = tagEnd;
+                        invalidate(false);
+                        break;
+                    }
+                    tag.append(ptr, tagEnd);
+                    ptr = tagEnd;
+                    break;
+                }
+                ++ptr;
+                if (scanner::isDelimiter(ch)) {
+                    emit();
+                }
+                else if (ch == '+' && mState == State::PreRelease) {
+                    mState = State::BuildFirst;
+                }
+                else {
+                    invalidate(false);
+                }
+                break;
+            }
+            case State::Skip: {
+                ++ptr;
+                if (scanner::isDelimiter(ch)) {
+                    mState = State::Delimiter;
+                }
+                break;
+            }
+        }
+    }
+    return mParsedCount - parsedBefore;
+}
+
+std::size_t sts::semver::StreamParser::finish() {
+    const std::size_t parsedBefore = mParsedCount;
+    // The same as a trailing whitespace.
+    feed(" ", 1);
+    mState = State::Delimiter;
+    return mParsedCount - parsedBefore;
+}
+
+void sts::semver::StreamParser::reset() {
+    mVersion.clear();
+    mNumber = 0;
+    mDigits = 0;
+    mParsedCount = 0;
+    mInvalidCount = 0;
+    mState = State::Delimiter;
+}
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Internal *////////////////////////////////////////////
+/**************************************************************************************************/
+
+bool sts::semver::StreamParser::pushDigit(const char ch) {
+    // 0|[1-9][0-9]*
+    if (mDigits != 0 && mNumber == 0) {
+        return false;
+    }
+    mNumber = mNumber * 10 + static_cast<std::uint64_t>(ch - '0');
+    ++mDigits;
+    return mNumber <= UINT32_MAX;
+}
+
+bool sts::semver::StreamParser::endNumber(std::uint32_t & outValue) {
+    const bool res = mDigits != 0;
+    outValue = static_cast<std::uint32_t>(mNumber);
+    mNumber = 0;
+    mDigits = 0;
+    return res;
+}
+
+void sts::semver::StreamParser::emit() {
+    ++mParsedCount;
+    mState = State::Delimiter;
+    if (mCallback) {
+        mCallback(mVersion);
+    }
+}
+
+void sts::semver::StreamParser::invalidate(const bool delimiterReached) {
+    ++mInvalidCount;
+    mNumber = 0;
+    mDigits = 0;
+    mState = delimiterReached ? State::Delimiter : State::Skip;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/
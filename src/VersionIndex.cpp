@@ -0,0 +1,496 @@
+/*
+**  Copyright(C) 2018, StepToSky
+**
+**  Redistribution and use in source and binary forms, with or without
+**  modification, are permitted provided that the following conditions are met:
+**
+**  1.Redistributions of source code must retain the above copyright notice, this
+**    list of conditions and the following disclaimer.
+**  2.Redistributions in binary form must reproduce the above copyright notice,
+**    this list of conditions and the following disclaimer in the documentation
+**    and / or other materials provided with the distribution.
+**  3.Neither the name of StepToSky nor the names of its contributors
+**    may be used to endorse or promote products derived from this software
+**    without specific prior written permission.
+**
+**  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+**  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+**  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+**  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+**  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+**  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+**  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+**  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+**  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+**  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**
+**  Contacts: www.steptosky.com
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include "sts/semver/VersionIndex.h"
+#include "Scanner.h"
+
+#ifdef _WIN32
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Local *////////////////////////////////////////////////
+/**************************************************************************************************/
+
+namespace {
+
+    const char gMagic[8] = {'S', 'T', 'S', 'S', 'V', 'I', 'D', 'X'};
+    const std::uint32_t gByteOrder = 0x01020304;
+
+    struct Header {
+        char mMagic[8];
+        std::uint32_t mFormat;
+        std::uint32_t mByteOrder;
+        std::uint64_t mFileSize;
+        std::uint64_t mCount;
+        std::uint64_t mEntriesOffset;
+        std::uint64_t mStringsOffset;
+        std::uint64_t mStringsSize;
+        std::uint64_t mChecksum;
+    };
+
+    struct Entry {
+        std::uint32_t mMajor;
+        std::uint32_t mMinor;
+        std::uint32_t mPatch;
+        std::uint32_t mPreReleaseOffset;
+        std::uint32_t mPreReleaseLength;
+        std::uint32_t mBuildOffset;
+        std::uint32_t mBuildLength;
+        std::uint32_t mReserved;
+    };
+
+    static_assert(sizeof(Header) == 64, "unexpected header size");
+    static_assert(sizeof(Entry) == 32, "unexpected entry size");
+
+    // The data may be not aligned so it is copied, compilers generate plain loads for this.
+    Entry readEntry(const std::uint8_t * entries, const std::size_t index) {
+        Entry res;
+        std::memcpy(&res, entries + index * sizeof(Entry), sizeof(Entry));
+        return res;
+    }
+
+    std::uint64_t checksum(const std::uint8_t * data, const std::size_t size) {
+        std::uint64_t res = 14695981039346656037ULL;
+        for (std::size_t i = 0; i < size; ++i) {
+            res ^= data[i];
+            res *= 1099511628211ULL;
+        }
+        return res;
+    }
+
+    // Precedence, then the pre-release and the build bytes.
+    bool lessVersion(const sts::semver::SemVersion & left, const sts::semver::SemVersion & right) {
+        const int res = left.comparePrecedence(right);
+        if (res != 0) {
+            return res < 0;
+        }
+        if (left.mPreRelease != right.mPreRelease) {
+            return left.mPreRelease < right.mPreRelease;
+        }
+        return left.mBuild < right.mBuild;
+    }
+
+    // Makes the temporary files of the concurrent writers unique within the process.
+    std::atomic<unsigned> gTempCounter(0);
+
+    /*
+     * Creates a new file with unique name next to the path, writes the data and flushes it to the disk,
+     * so after a crash the file is either complete or it wasn't renamed.
+     * Returns the name of the file or an empty string if it failed.
+     */
+    std::string writeTempFile(const std::string & path, const std::vector<std::uint8_t> & data) {
+        for (int attempt = 0; attempt < 100; ++attempt) {
+#ifdef _WIN32
+            const std::string temp = path + ".tmp." + std::to_string(GetCurrentProcessId()) + "." + std::to_string(gTempCounter++);
+            const HANDLE file = CreateFileA(temp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) {
+                if (GetLastError() == ERROR_FILE_EXISTS) {
+                    continue;
+                }
+                return std::string();
+            }
+            bool ok = true;
+            std::size_t offset = 0;
+            while (ok && offset != data.size()) {
+                DWORD written = 0;
+                const DWORD size = static_cast<DWORD>(std::min<std::size_t>(data.size() - offset, 1 << 30));
+                ok = WriteFile(file, data.data() + offset, size, &written, nullptr) != 0;
+                offset += written;
+            }
+            ok = ok && FlushFileBuffers(file) != 0;
+            ok = CloseHandle(file) != 0 && ok;
+#else
+            const std::string temp = path + ".tmp." + std::to_string(getpid()) + "." + std::to_string(gTempCounter++);
+            const int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+            if (fd == -1) {
+                if (errno == EEXIST) {
+                    continue;
+                }
+                return std::string();
+            }
+            bool ok = true;
+            std::size_t offset = 0;
+            while (ok && offset != data.size()) {
+                const ssize_t written = ::write(fd, data.data() + offset, data.size() - offset);
+                if (written < 0) {
+                    ok = errno == EINTR;
+                    continue;
+                }
+                offset += static_cast<std::size_t>(written);
+            }
+            ok = ok && fsync(fd) == 0;
+            ok = ::close(fd) == 0 && ok;
+#endif
+            if (!ok) {
+                std::remove(temp.c_str());
+                return std::string();
+            }
+            return temp;
+        }
+        return std::string();
+    }
+
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////* Constructors/Destructor *//////////////////////////////////
+/**************************************************************************************************/
+
+const std::uint32_t sts::semver::VersionIndex::FormatVersion;
+const std::size_t sts::semver::VersionIndex::npos;
+
+sts::semver::VersionIndex::VersionIndex(const void * data, const std::size_t size, const bool verifyChecksum) {
+    const std::uint8_t * bytes = static_cast<const std::uint8_t *>(data);
+    Header header;
+    if (!bytes || size < sizeof(Header)) {
+        return;
+    }
+    std::memcpy(&header, bytes, sizeof(Header));
+    if (std::memcmp(header.mMagic, gMagic, sizeof(gMagic)) != 0 ||
+        header.mFormat != FormatVersion || header.mByteOrder != gByteOrder || header.mFileSize != size) {
+        return;
+    }
+    // the sections must be inside the data, the sizes are checked by division to avoid overflow
+    if (header.mEntriesOffset != sizeof(Header) ||
+        header.mCount > (size - sizeof(Header)) / sizeof(Entry) ||
+        header.mStringsOffset != header.mEntriesOffset + header.mCount * sizeof(Entry) ||
+        header.mStringsSize != size - header.mStringsOffset) {
+        return;
+    }
+    if (verifyChecksum && header.mChecksum != checksum(bytes + sizeof(Header), size - sizeof(Header))) {
+        return;
+    }
+    const std::uint8_t * entries = bytes + header.mEntriesOffset;
+    const std::size_t count = static_cast<std::size_t>(header.mCount);
+    for (std::size_t i = 0; i < count; ++i) {
+        const Entry e = readEntry(entries, i);
+        if (std::uint64_t(e.mPreReleaseOffset) + e.mPreReleaseLength > header.mStringsSize ||
+            std::uint64_t(e.mBuildOffset) + e.mBuildLength > header.mStringsSize) {
+            return;
+        }
+    }
+    mEntries = entries;
+    mStrings = reinterpret_cast<const char *>(bytes + header.mStringsOffset);
+    mCount = count;
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Functions */////////////////////////////////////////////
+/**************************************************************************************************/
+
+void sts::semver::VersionIndex::version(const std::size_t index, SemVersion & outVersion) const {
+    const Entry e = readEntry(mEntries, index);
+    outVersion.set(e.mMajor, e.mMinor, e.mPatch,
+                   mStrings + e.mPreReleaseOffset, e.mPreReleaseLength,
+                   mStrings + e.mBuildOffset, e.mBuildLength);
+}
+
+std::size_t sts::semver::VersionIndex::find(const SemVersion & version) const STS_SEMVER_NOEXCEPT {
+    for (std::size_t i = lowerBound(version); i < mCount && comparePrecedence(i, version) == 0; ++i) {
+        const Entry e = readEntry(mEntries, i);
+        if (e.mPreReleaseLength == version.mPreRelease.length() && e.mBuildLength == version.mBuild.length() &&
+            std::memcmp(mStrings + e.mPreReleaseOffset, version.mPreRelease.data(), e.mPreReleaseLength) == 0 &&
+            std::memcmp(mStrings + e.mBuildOffset, version.mBuild.data(), e.mBuildLength) == 0) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+std::size_t sts::semver::VersionIndex::lowerBound(const SemVersion & version) const STS_SEMVER_NOEXCEPT {
+    std::size_t first = 0;
+    std::size_t count = mCount;
+    while (count != 0) {
+        const std::size_t half = count / 2;
+        if (comparePrecedence(first + half, version) < 0) {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+std::size_t sts::semver::VersionIndex::upperBound(const SemVersion & version) const STS_SEMVER_NOEXCEPT {
+    std::size_t first = 0;
+    std::size_t count = mCount;
+    while (count != 0) {
+        const std::size_t half = count / 2;
+        if (comparePrecedence(first + half, version) <= 0) {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+std::size_t sts::semver::VersionIndex::maxSatisfying(const Range & range) const STS_SEMVER_NOEXCEPT {
+    std::size_t res = npos;
+    for (auto & set : range.mSets) {
+        // [begin, end) of the versions which satisfy all the comparators
+        std::size_t begin = 0;
+        std::size_t end = mCount;
+        for (auto & c : set) {
+            switch (c.mOperation) {
+                case Range::Operation::Equal:
+                    begin = std::max(begin, lowerBound(c.mVersion));
+                    end = std::min(end, upperBound(c.mVersion));
+                    break;
+                case Range::Operation::Less:
+                    end = std::min(end, lowerBound(c.mVersion));
+                    break;
+                case Range::Operation::LessOrEqual:
+                    end = std::min(end, upperBound(c.mVersion));
+                    break;
+                case Range::Operation::Greater:
+                    begin = std::max(begin, upperBound(c.mVersion));
+                    break;
+                case Range::Operation::GreaterOrEqual:
+                    begin = std::max(begin, lowerBound(c.mVersion));
+                    break;
+            }
+        }
+        if (begin < end && (res == npos || end - 1 > res)) {
+            res = end - 1;
+        }
+    }
+    return res;
+}
+
+/**************************************************************************************************/
+//////////////////////////////////////////* Building *//////////////////////////////////////////////
+/**************************************************************************************************/
+
+std::vector<std::uint8_t> sts::semver::VersionIndex::build(const std::vector<SemVersion> & versions) {
+    std::vector<const SemVersion *> sorted;
+    sorted.reserve(versions.size());
+    for (auto & v : versions) {
+        sorted.push_back(&v);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const SemVersion * l, const SemVersion * r) {
+        return lessVersion(*l, *r);
+    });
+    sorted.erase(std::unique(sorted.begin(), sorted.end(), [](const SemVersion * l, const SemVersion * r) {
+        return !lessVersion(*l, *r) && !lessVersion(*r, *l);
+    }), sorted.end());
+
+    std::string strings;
+    std::unordered_map<std::string, std::uint32_t> offsets;
+    const auto addString = [&](const std::string & str) -> std::uint32_t {
+        if (str.empty()) {
+            return 0;
+        }
+        const auto found = offsets.find(str);
+        if (found != offsets.end()) {
+            return found->second;
+        }
+        const std::uint32_t offset = static_cast<std::uint32_t>(strings.size());
+        strings.append(str);
+        offsets.emplace(str, offset);
+        return offset;
+    };
+
+    Header header;
+    std::memcpy(header.mMagic, gMagic, sizeof(gMagic));
+    header.mFormat = FormatVersion;
+    header.mByteOrder = gByteOrder;
+    header.mCount = sorted.size();
+    header.mEntriesOffset = sizeof(Header);
+    header.mStringsOffset = header.mEntriesOffset + sorted.size() * sizeof(Entry);
+
+    std::vector<std::uint8_t> res(static_cast<std::size_t>(header.mStringsOffset));
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        const SemVersion & v = *sorted[i];
+        Entry e;
+        e.mMajor = v.mMajor;
+        e.mMinor = v.mMinor;
+        e.mPatch = v.mPatch;
+        e.mPreReleaseOffset = addString(v.mPreRelease);
+        e.mPreReleaseLength = static_cast<std::uint32_t>(v.mPreRelease.length());
+        e.mBuildOffset = addString(v.mBuild);
+        e.mBuildLength = static_cast<std::uint32_t>(v.mBuild.length());
+        e.mReserved = 0;
+        std::memcpy(res.data() + header.mEntriesOffset + i * sizeof(Entry), &e, sizeof(Entry));
+    }
+    res.insert(res.end(), strings.begin(), strings.end());
+    header.mStringsSize = strings.size();
+    header.mFileSize = res.size();
+    header.mChecksum = checksum(res.data() + sizeof(Header), res.size() - sizeof(Header));
+    std::memcpy(res.data(), &header, sizeof(Header));
+    return res;
+}
+
+bool sts::semver::VersionIndex::write(const std::vector<SemVersion> & versions, const std::string & path) {
+    const std::vector<std::uint8_t> data = build(versions);
+    const std::string temp = writeTempFile(path, data);
+    if (temp.empty()) {
+        return false;
+    }
+#ifdef _WIN32
+    if (!MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+#else
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+#endif
+        std::remove(temp.c_str());
+        return false;
+    }
+#ifndef _WIN32
+    // the directory entry must survive a crash too
+    const std::size_t slash = path.rfind('/');
+    const std::string dir = slash == std::string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash);
+    const int dirFd = ::open(dir.c_str(), O_RDONLY);
+    if (dirFd != -1) {
+        fsync(dirFd);
+        ::close(dirFd);
+    }
+#endif
+    return true;
+}
+
+/**************************************************************************************************/
+///////////////////////////////////////////* Internal *////////////////////////////////////////////
+/**************************************************************************************************/
+
+int sts::semver::VersionIndex::comparePrecedence(const std::size_t index, const SemVersion & version) const STS_SEMVER_NOEXCEPT {
+    const Entry e = readEntry(mEntries, index);
+    if (e.mMajor != version.mMajor) {
+        return e.mMajor < version.mMajor ? -1 : 1;
+    }
+    if (e.mMinor != version.mMinor) {
+        return e.mMinor < version.mMinor ? -1 : 1;
+    }
+    if (e.mPatch != version.mPatch) {
+        return e.mPatch < version.mPatch ? -1 : 1;
+    }
+    return scanner::comparePreRelease(mStrings + e.mPreReleaseOffset, e.mPreReleaseLength,
+                                      version.mPreRelease.data(), version.mPreRelease.length());
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////* VersionIndexFile *////////////////////////////////////////
+/**************************************************************************************************/
+
+bool sts::semver::VersionIndexFile::open(const std::string & path, const bool verifyChecksum) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    mFile = file;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        close();
+        return false;
+    }
+    mMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mMapping) {
+        close();
+        return false;
+    }
+    mData = MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+    if (!mData) {
+        close();
+        return false;
+    }
+    mSize = static_cast<std::size_t>(size.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void * mapped = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    mData = mapped;
+    mSize = static_cast<std::size_t>(st.st_size);
+#endif
+    mIndex = VersionIndex(mData, mSize, verifyChecksum);
+    if (!mIndex.isValid()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void sts::semver::VersionIndexFile::close() {
+    mIndex = VersionIndex();
+#ifdef _WIN32
+    if (mData) {
+        UnmapViewOfFile(mData);
+    }
+    if (mMapping) {
+        CloseHandle(mMapping);
+    }
+    if (mFile) {
+        CloseHandle(mFile);
+    }
+    mMapping = nullptr;
+    mFile = nullptr;
+#else
+    if (mData) {
+        munmap(mData, mSize);
+    }
+#endif
+    mData = nullptr;
+    mSize = 0;
+}
+
+/**************************************************************************************************/
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/**************************************************************************************************/